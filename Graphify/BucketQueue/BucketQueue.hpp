@@ -0,0 +1,55 @@
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include <vector>
+#include <utility>
+
+namespace Graphify{
+
+    /*
+        Dial's bucket queue for monotone integer keys (Dijkstra with non-negative integer weights).
+
+        While Dijkstra runs, every key in the queue lies in [current, current + maxWeight], so
+        maxWeight + 1 buckets used as a ring are enough, and push / pop are O(1) (amortized over
+        the scan of empty buckets). Entries are lazy: a node is pushed again whenever its distance
+        improves, and the caller skips entries whose key no longer matches the node's distance.
+    */
+    class BucketQueue{
+        public:
+            BucketQueue(int maxWeight);
+
+            bool empty();
+            void push(long long key, int id);
+            std::pair<long long, int> pop(); // {key, id} with the smallest key
+
+        private:
+            std::vector<std::vector<int>> buckets;
+            long long currentKey;
+            size_t count;
+    };
+
+    inline BucketQueue::BucketQueue(int maxWeight)
+    : buckets(maxWeight + 1), currentKey(0), count(0)
+    { }
+
+    inline bool BucketQueue::empty(){
+        return count == 0;
+    }
+
+    inline void BucketQueue::push(long long key, int id){
+        buckets[key % buckets.size()].push_back(id);
+        count++;
+    }
+
+    inline std::pair<long long, int> BucketQueue::pop(){
+        while(buckets[currentKey % buckets.size()].empty()) currentKey++;
+
+        auto& bucket = buckets[currentKey % buckets.size()];
+        int id = bucket.back();
+        bucket.pop_back();
+        count--;
+        return {currentKey, id};
+    }
+}
+
+#endif // BUCKETQUEUE_HPP
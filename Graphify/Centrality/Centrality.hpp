@@ -0,0 +1,373 @@
+#ifndef CENTRALITY_HPP
+#define CENTRALITY_HPP
+
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "Parallel/Parallel.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include <map>
+#include <vector>
+#include <cmath>
+#include <queue>
+#include <random>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T>
+    class Graph;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    template <class T, class W = int>
+    class Centrality{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            // For weighted graphs a node splits its rank between its out-edges in proportion to their (non-negative) weights.
+            std::map<Node<T>*, double> pageRank(Graph<T>& graph, double damping=0.85, double tolerance=1e-9, int maxIterations=100, int numThreads=0);
+            std::map<Node<T>*, double> pageRank(WeightedGraph<T, W>& graph, double damping=0.85, double tolerance=1e-9, int maxIterations=100, int numThreads=0);
+
+            // Teleports (and dangling nodes) jump only to the given nodes, in proportion to their values.
+            std::map<Node<T>*, double> personalizedPageRank(Graph<T>& graph, std::map<Node<T>*, double> personalization, double damping=0.85, double tolerance=1e-9, int maxIterations=100, int numThreads=0);
+            std::map<Node<T>*, double> personalizedPageRank(WeightedGraph<T, W>& graph, std::map<Node<T>*, double> personalization, double damping=0.85, double tolerance=1e-9, int maxIterations=100, int numThreads=0);
+
+            // Pairs are ordered (s, t), so on undirected graphs every path is counted from both ends.
+            std::map<Node<T>*, double> betweennessCentrality(Graph<T>& graph, bool normalized=false, int numThreads=0);
+            std::map<Node<T>*, double> betweennessCentrality(WeightedGraph<T, W>& graph, bool normalized=false, int numThreads=0);
+
+            // Brandes from numSamples random pivots only, scaled up by V / numSamples. Unbiased estimate of the above.
+            std::map<Node<T>*, double> approximateBetweennessCentrality(Graph<T>& graph, int numSamples, unsigned seed=0, bool normalized=false, int numThreads=0);
+            std::map<Node<T>*, double> approximateBetweennessCentrality(WeightedGraph<T, W>& graph, int numSamples, unsigned seed=0, bool normalized=false, int numThreads=0);
+
+            // CSR versions, indexed by the CSR's node indices. An empty personalization means uniform.
+            std::vector<double> pageRank(CompressedGraph<T, W>& graph, std::vector<double> personalization={}, double damping=0.85, double tolerance=1e-9, int maxIterations=100, int numThreads=0);
+            std::vector<double> betweennessCentrality(CompressedGraph<T, W>& graph, std::vector<int> sources, double scale=1, int numThreads=0);
+
+        private:
+            // per thread scratch space for one Brandes single source pass, reused across sources
+            struct BrandesWorkspace{
+                std::vector<Distance> distance; // hops for unweighted graphs, path weight otherwise
+                std::vector<double> numShortestPaths;
+                std::vector<double> dependency;
+                std::vector<char> settled; // only used by the weighted pass
+                std::vector<int> settledOrder;
+            };
+
+            void brandesBFS(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality);
+            void brandesDijkstra(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality);
+            void brandesAccumulate(CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality);
+
+            std::map<Node<T>*, double> betweennessFromSamples(CompressedGraph<T, W>& graph, int numSamples, unsigned seed, bool normalized, int numThreads);
+
+            std::map<Node<T>*, double> nodeValues(CompressedGraph<T, W>& graph, std::vector<double>& values);
+            std::vector<double> indexValues(CompressedGraph<T, W>& graph, std::map<Node<T>*, double>& values);
+    };
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::pageRank(Graph<T>& graph, double damping, double tolerance, int maxIterations, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto ranks = pageRank(compressedGraph, {}, damping, tolerance, maxIterations, numThreads);
+        return nodeValues(compressedGraph, ranks);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::pageRank(WeightedGraph<T, W>& graph, double damping, double tolerance, int maxIterations, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto ranks = pageRank(compressedGraph, {}, damping, tolerance, maxIterations, numThreads);
+        return nodeValues(compressedGraph, ranks);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::personalizedPageRank(Graph<T>& graph, std::map<Node<T>*, double> personalization, double damping, double tolerance, int maxIterations, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto ranks = pageRank(compressedGraph, indexValues(compressedGraph, personalization), damping, tolerance, maxIterations, numThreads);
+        return nodeValues(compressedGraph, ranks);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::personalizedPageRank(WeightedGraph<T, W>& graph, std::map<Node<T>*, double> personalization, double damping, double tolerance, int maxIterations, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto ranks = pageRank(compressedGraph, indexValues(compressedGraph, personalization), damping, tolerance, maxIterations, numThreads);
+        return nodeValues(compressedGraph, ranks);
+    }
+
+    /*
+        Power iteration, one pull-based sparse matrix-vector product per step:
+
+            rank'[v] = (1 - d) * p[v] + d * (sum over edges u->v of share(u, v) + dangling * p[v])
+
+        where share(u, v) is u's rank times the fraction of u's out-weight going to v, and
+        dangling is the total rank of nodes without out-edges (it would leak out of the
+        graph otherwise). Pulling over the transposed CSR means each thread only writes
+        the rows it owns, so no atomics are needed. Stops when the L1 change is below tolerance.
+    */
+    template <class T, class W>
+    std::vector<double> Centrality<T, W>::pageRank(CompressedGraph<T, W>& graph, std::vector<double> personalization, double damping, double tolerance, int maxIterations, int numThreads){
+        int V = graph.size();
+        if(V == 0) return {};
+
+        if(personalization.empty()) personalization.assign(V, 1.0);
+        double personalizationSum = 0;
+        for(auto value : personalization) personalizationSum += value;
+        if(personalizationSum <= 0){ // nothing to personalize to.. fall back to uniform
+            personalization.assign(V, 1.0);
+            personalizationSum = V;
+        }
+        for(auto& value : personalization) value /= personalizationSum;
+
+        bool weighted = graph.isWeighted();
+        auto transposedGraph = graph.transposed();
+
+        std::vector<double> outWeight(V, 0);
+        for(int u = 0; u < V; u++){
+            if(!weighted){
+                outWeight[u] = graph.outDegree(u);
+                continue;
+            }
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++) outWeight[u] += std::max<double>(0, graph.weights[e]);
+        }
+
+        std::vector<double> rank = personalization;
+        std::vector<double> nextRank(V, 0);
+        std::vector<double> share(V, 0);
+
+        int threads = resolveNumThreads(numThreads, V);
+        std::vector<double> threadDangling(threads);
+        std::vector<double> threadChange(threads);
+
+        for(int iteration = 0; iteration < maxIterations; iteration++){
+            std::fill(threadDangling.begin(), threadDangling.end(), 0);
+            std::fill(threadChange.begin(), threadChange.end(), 0);
+
+            parallelFor(0, V, [&](int u, int threadId){
+                if(outWeight[u] > 0) share[u] = rank[u] / outWeight[u];
+                else{
+                    share[u] = 0;
+                    threadDangling[threadId] += rank[u];
+                }
+            }, threads, 1024);
+
+            double dangling = 0;
+            for(auto value : threadDangling) dangling += value;
+
+            parallelFor(0, V, [&](int v, int threadId){
+                double incoming = 0;
+                for(int e = transposedGraph.offsets[v]; e < transposedGraph.offsets[v+1]; e++){
+                    int u = transposedGraph.targets[e];
+                    incoming += weighted ? share[u] * std::max<double>(0, transposedGraph.weights[e]) : share[u];
+                }
+                nextRank[v] = (1 - damping) * personalization[v] + damping * (incoming + dangling * personalization[v]);
+                threadChange[threadId] += std::fabs(nextRank[v] - rank[v]);
+            }, threads, 256);
+
+            std::swap(rank, nextRank);
+
+            double change = 0;
+            for(auto value : threadChange) change += value;
+            if(change < tolerance) break;
+        }
+        return rank;
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::betweennessCentrality(Graph<T>& graph, bool normalized, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return betweennessFromSamples(compressedGraph, compressedGraph.size(), 0, normalized, numThreads);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::betweennessCentrality(WeightedGraph<T, W>& graph, bool normalized, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return betweennessFromSamples(compressedGraph, compressedGraph.size(), 0, normalized, numThreads);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::approximateBetweennessCentrality(Graph<T>& graph, int numSamples, unsigned seed, bool normalized, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return betweennessFromSamples(compressedGraph, numSamples, seed, normalized, numThreads);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::approximateBetweennessCentrality(WeightedGraph<T, W>& graph, int numSamples, unsigned seed, bool normalized, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return betweennessFromSamples(compressedGraph, numSamples, seed, normalized, numThreads);
+    }
+
+    /*
+        Brandes' algorithm: one BFS (or Dijkstra, for weighted graphs) per source, then the
+        dependencies are accumulated back in reverse settling order. Sources are split across
+        threads and every thread adds into its own centrality vector, which are summed at the end.
+    */
+    template <class T, class W>
+    std::vector<double> Centrality<T, W>::betweennessCentrality(CompressedGraph<T, W>& graph, std::vector<int> sources, double scale, int numThreads){
+        int V = graph.size();
+        auto transposedGraph = graph.transposed();
+
+        int threads = resolveNumThreads(numThreads, int(sources.size()));
+        std::vector<std::vector<double>> threadCentrality(threads);
+        std::vector<BrandesWorkspace> workspaces(threads);
+
+        parallelFor(0, int(sources.size()), [&](int i, int threadId){
+            auto& centrality = threadCentrality[threadId];
+            auto& workspace = workspaces[threadId];
+            if(centrality.empty()){ // first source on this thread
+                centrality.assign(V, 0);
+                workspace.distance.assign(V, -1);
+                workspace.numShortestPaths.assign(V, 0);
+                workspace.dependency.assign(V, 0);
+                workspace.settled.assign(V, 0);
+            }
+            if(graph.isWeighted()) brandesDijkstra(graph, transposedGraph, sources[i], workspace, centrality);
+            else brandesBFS(graph, transposedGraph, sources[i], workspace, centrality);
+        }, threads, 1);
+
+        std::vector<double> centrality(V, 0);
+        for(auto& partial : threadCentrality){
+            if(partial.empty()) continue;
+            for(int v = 0; v < V; v++) centrality[v] += partial[v];
+        }
+        for(auto& value : centrality) value *= scale;
+        return centrality;
+    }
+
+    template <class T, class W>
+    void Centrality<T, W>::brandesBFS(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality){
+        auto& distance = workspace.distance;
+        auto& numShortestPaths = workspace.numShortestPaths;
+        auto& settledOrder = workspace.settledOrder;
+
+        settledOrder.clear();
+        distance[source] = 0;
+        numShortestPaths[source] = 1;
+        settledOrder.push_back(source);
+
+        // settledOrder doubles as the BFS queue, it is already in nondecreasing distance order
+        for(size_t head = 0; head < settledOrder.size(); head++){
+            int v = settledOrder[head];
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                int w = graph.targets[e];
+                if(distance[w] == -1){
+                    distance[w] = distance[v] + 1;
+                    settledOrder.push_back(w);
+                }
+                if(distance[w] == distance[v] + 1) numShortestPaths[w] += numShortestPaths[v];
+            }
+        }
+        brandesAccumulate(transposedGraph, source, workspace, centrality);
+    }
+
+    // expects non-negative weights, like every Dijkstra
+    template <class T, class W>
+    void Centrality<T, W>::brandesDijkstra(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality){
+        auto& distance = workspace.distance;
+        auto& numShortestPaths = workspace.numShortestPaths;
+        auto& settled = workspace.settled;
+        auto& settledOrder = workspace.settledOrder;
+
+        settledOrder.clear();
+        distance[source] = 0;
+        numShortestPaths[source] = 1;
+
+        std::priority_queue<std::pair<Distance, int>, std::vector<std::pair<Distance, int>>, std::greater<std::pair<Distance, int>>> nodesToVisit;
+        nodesToVisit.push({0, source});
+
+        while(!nodesToVisit.empty()){
+            auto [currentDistance, v] = nodesToVisit.top();
+            nodesToVisit.pop();
+            if(settled[v] || currentDistance != distance[v]) continue; // stale entry..
+
+            settled[v] = 1;
+            settledOrder.push_back(v);
+
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                int w = graph.targets[e];
+                Distance newDistance = distance[v] + graph.weights[e];
+                if(distance[w] == -1 || newDistance < distance[w]){
+                    distance[w] = newDistance;
+                    numShortestPaths[w] = numShortestPaths[v];
+                    nodesToVisit.push({newDistance, w});
+                }
+                else if(newDistance == distance[w]){
+                    numShortestPaths[w] += numShortestPaths[v];
+                }
+            }
+        }
+        brandesAccumulate(transposedGraph, source, workspace, centrality);
+    }
+
+    /*
+        delta[v] = sum over successors w on a shortest path of sigma[v] / sigma[w] * (1 + delta[w]).
+        Predecessors are found by scanning in-edges instead of storing lists per node, which
+        keeps the workspace O(V). Everything touched is reset so the workspace can be reused.
+    */
+    template <class T, class W>
+    void Centrality<T, W>::brandesAccumulate(CompressedGraph<T, W>& transposedGraph, int source, BrandesWorkspace& workspace, std::vector<double>& centrality){
+        auto& distance = workspace.distance;
+        auto& numShortestPaths = workspace.numShortestPaths;
+        auto& dependency = workspace.dependency;
+        auto& settledOrder = workspace.settledOrder;
+        bool weighted = transposedGraph.isWeighted();
+
+        for(auto it = settledOrder.rbegin(); it != settledOrder.rend(); it++){
+            int w = *it;
+            double coefficient = (1 + dependency[w]) / numShortestPaths[w];
+            for(int e = transposedGraph.offsets[w]; e < transposedGraph.offsets[w+1]; e++){
+                int v = transposedGraph.targets[e];
+                if(distance[v] == -1) continue;
+                Distance edgeLength = weighted ? Distance(transposedGraph.weights[e]) : 1;
+                if(distance[v] + edgeLength == distance[w]) dependency[v] += numShortestPaths[v] * coefficient;
+            }
+            if(w != source) centrality[w] += dependency[w];
+        }
+
+        for(auto v : settledOrder){
+            distance[v] = -1;
+            numShortestPaths[v] = 0;
+            dependency[v] = 0;
+            workspace.settled[v] = 0;
+        }
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::betweennessFromSamples(CompressedGraph<T, W>& graph, int numSamples, unsigned seed, bool normalized, int numThreads){
+        int V = graph.size();
+        numSamples = std::max(0, std::min(numSamples, V));
+
+        std::vector<int> sources(V);
+        for(int i = 0; i < V; i++) sources[i] = i;
+        if(numSamples < V){ // pick numSamples distinct pivots
+            std::mt19937 generator(seed);
+            std::shuffle(sources.begin(), sources.end(), generator);
+            sources.resize(numSamples);
+        }
+
+        double scale = numSamples > 0 ? double(V) / numSamples : 0;
+        if(normalized && V > 2) scale /= double(V - 1) * (V - 2);
+
+        auto centrality = betweennessCentrality(graph, sources, scale, numThreads);
+        return nodeValues(graph, centrality);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, double> Centrality<T, W>::nodeValues(CompressedGraph<T, W>& graph, std::vector<double>& values){
+        std::map<Node<T>*, double> valueMap;
+        for(int i = 0; i < graph.size(); i++) valueMap[graph.nodes[i]] = values[i];
+        return valueMap;
+    }
+
+    template <class T, class W>
+    std::vector<double> Centrality<T, W>::indexValues(CompressedGraph<T, W>& graph, std::map<Node<T>*, double>& values){
+        std::vector<double> valueVector(graph.size(), 0);
+        for(auto [node, value] : values){
+            int i = graph.index(node);
+            if(i != -1) valueVector[i] = value;
+        }
+        return valueVector;
+    }
+}
+
+#endif // CENTRALITY_HPP
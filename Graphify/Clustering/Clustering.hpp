@@ -0,0 +1,300 @@
+#ifndef CLUSTERING_HPP
+#define CLUSTERING_HPP
+
+#include "Graph/Graph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "Parallel/Parallel.hpp"
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Graphify{
+
+    template <class T>
+    class Graph;
+
+    /*
+        Triangle and clustering statistics. Edge directions are ignored- a triangle is
+        any three nodes that are pairwise connected in either direction.
+    */
+    template <class T>
+    class Clustering{
+        public:
+            long long numTriangles(Graph<T>& graph, int numThreads=0);
+            std::map<Node<T>*, long long> triangleCounts(Graph<T>& graph, int numThreads=0);
+            std::map<Node<T>*, double> localClusteringCoefficients(Graph<T>& graph, int numThreads=0);
+            double averageClusteringCoefficient(Graph<T>& graph, int numThreads=0);
+            double globalClusteringCoefficient(Graph<T>& graph, int numThreads=0); // a.k.a. transitivity
+
+            // same as above but on a prebuilt CSR, indexed by the CSR's node indices
+            long long numTriangles(CompressedGraph<T>& graph, int numThreads=0);
+            std::vector<long long> triangleCounts(CompressedGraph<T>& graph, int numThreads=0);
+            std::vector<double> localClusteringCoefficients(CompressedGraph<T>& graph, int numThreads=0);
+
+        private:
+            /*
+                The undirected graph relabeled by (degree, index) rank. higher[v] holds the
+                neighbors that rank above v and lower[v] the ones below, both sorted, so
+                every triangle u < v < w is found exactly once by intersecting higher[u] and higher[v].
+                Orienting towards higher degree keeps the lists hubs intersect short.
+            */
+            struct DegreeOrderedGraph{
+                std::vector<int> rankToIndex;
+                std::vector<int> degree; // undirected degree, by rank
+                std::vector<int> higherOffsets;
+                std::vector<int> higher;
+                std::vector<int> lowerOffsets;
+                std::vector<int> lower;
+            };
+
+            DegreeOrderedGraph degreeOrder(CompressedGraph<T>& graph);
+
+            static long long intersectionSize(const int* a, int aSize, const int* b, int bSize);
+    };
+
+    template <class T>
+    long long Clustering<T>::numTriangles(Graph<T>& graph, int numThreads){
+        CompressedGraph<T> compressedGraph(graph);
+        return numTriangles(compressedGraph, numThreads);
+    }
+
+    template <class T>
+    std::map<Node<T>*, long long> Clustering<T>::triangleCounts(Graph<T>& graph, int numThreads){
+        CompressedGraph<T> compressedGraph(graph);
+        auto counts = triangleCounts(compressedGraph, numThreads);
+
+        std::map<Node<T>*, long long> nodeTriangles;
+        for(int i = 0; i < compressedGraph.size(); i++) nodeTriangles[compressedGraph.nodes[i]] = counts[i];
+        return nodeTriangles;
+    }
+
+    template <class T>
+    std::map<Node<T>*, double> Clustering<T>::localClusteringCoefficients(Graph<T>& graph, int numThreads){
+        CompressedGraph<T> compressedGraph(graph);
+        auto coefficients = localClusteringCoefficients(compressedGraph, numThreads);
+
+        std::map<Node<T>*, double> nodeCoefficients;
+        for(int i = 0; i < compressedGraph.size(); i++) nodeCoefficients[compressedGraph.nodes[i]] = coefficients[i];
+        return nodeCoefficients;
+    }
+
+    template <class T>
+    double Clustering<T>::averageClusteringCoefficient(Graph<T>& graph, int numThreads){
+        CompressedGraph<T> compressedGraph(graph);
+        if(compressedGraph.size() == 0) return 0;
+
+        double sum = 0;
+        for(auto coefficient : localClusteringCoefficients(compressedGraph, numThreads)) sum += coefficient;
+        return sum / compressedGraph.size();
+    }
+
+    // 3 * triangles / connected triples
+    template <class T>
+    double Clustering<T>::globalClusteringCoefficient(Graph<T>& graph, int numThreads){
+        CompressedGraph<T> compressedGraph(graph);
+        auto undirectedGraph = compressedGraph.undirected();
+
+        long long triples = 0;
+        for(int i = 0; i < undirectedGraph.size(); i++){
+            long long degree = undirectedGraph.outDegree(i);
+            triples += degree * (degree - 1) / 2;
+        }
+        if(triples == 0) return 0;
+
+        return 3.0 * numTriangles(compressedGraph, numThreads) / triples;
+    }
+
+    template <class T>
+    long long Clustering<T>::numTriangles(CompressedGraph<T>& graph, int numThreads){
+        auto ordered = degreeOrder(graph);
+        int V = int(ordered.degree.size());
+
+        std::vector<long long> threadTriangles(resolveNumThreads(numThreads, V), 0);
+
+        parallelFor(0, V, [&](int u, int threadId){
+            const int* higherU = ordered.higher.data() + ordered.higherOffsets[u];
+            int higherUSize = ordered.higherOffsets[u+1] - ordered.higherOffsets[u];
+
+            long long triangles = 0;
+            for(int e = 0; e < higherUSize; e++){
+                int v = higherU[e];
+                // w > v for any w shared with higher[v], so only the tail of higher[u] can match
+                triangles += intersectionSize(higherU + e + 1, higherUSize - e - 1,
+                                              ordered.higher.data() + ordered.higherOffsets[v], ordered.higherOffsets[v+1] - ordered.higherOffsets[v]);
+            }
+            threadTriangles[threadId] += triangles;
+        }, numThreads);
+
+        long long triangles = 0;
+        for(auto count : threadTriangles) triangles += count;
+        return triangles;
+    }
+
+    /*
+        For a triangle u < v < w (by rank) every corner is counted from its own row,
+        so no two threads ever write to the same slot:
+            u (lowest): higher[u] & higher[v] for v in higher[u]
+            v (middle): higher[u] & higher[v] for u in lower[v]
+            w (highest): lower[v] & lower[w] for v in lower[w]
+    */
+    template <class T>
+    std::vector<long long> Clustering<T>::triangleCounts(CompressedGraph<T>& graph, int numThreads){
+        auto ordered = degreeOrder(graph);
+        int V = int(ordered.degree.size());
+
+        std::vector<long long> counts(V, 0);
+
+        auto higherRow = [&](int x){ return ordered.higher.data() + ordered.higherOffsets[x]; };
+        auto higherSize = [&](int x){ return ordered.higherOffsets[x+1] - ordered.higherOffsets[x]; };
+        auto lowerRow = [&](int x){ return ordered.lower.data() + ordered.lowerOffsets[x]; };
+        auto lowerSize = [&](int x){ return ordered.lowerOffsets[x+1] - ordered.lowerOffsets[x]; };
+
+        parallelFor(0, V, [&](int x){
+            long long triangles = 0;
+            for(int e = 0; e < higherSize(x); e++){
+                int y = higherRow(x)[e];
+                triangles += intersectionSize(higherRow(x), higherSize(x), higherRow(y), higherSize(y));
+            }
+            for(int e = 0; e < lowerSize(x); e++){
+                int y = lowerRow(x)[e];
+                triangles += intersectionSize(higherRow(y), higherSize(y), higherRow(x), higherSize(x));
+                triangles += intersectionSize(lowerRow(y), lowerSize(y), lowerRow(x), lowerSize(x));
+            }
+            counts[ordered.rankToIndex[x]] = triangles;
+        }, numThreads);
+
+        return counts;
+    }
+
+    template <class T>
+    std::vector<double> Clustering<T>::localClusteringCoefficients(CompressedGraph<T>& graph, int numThreads){
+        auto undirectedGraph = graph.undirected();
+        auto counts = triangleCounts(graph, numThreads);
+
+        std::vector<double> coefficients(graph.size(), 0);
+        for(int i = 0; i < graph.size(); i++){
+            double degree = undirectedGraph.outDegree(i);
+            if(degree < 2) continue; // by convention a node with fewer than 2 neighbors has coefficient 0
+            coefficients[i] = 2.0 * counts[i] / (degree * (degree - 1));
+        }
+        return coefficients;
+    }
+
+    template <class T>
+    typename Clustering<T>::DegreeOrderedGraph Clustering<T>::degreeOrder(CompressedGraph<T>& graph){
+        auto undirectedGraph = graph.undirected();
+        int V = undirectedGraph.size();
+
+        DegreeOrderedGraph ordered;
+        ordered.rankToIndex.resize(V);
+        for(int i = 0; i < V; i++) ordered.rankToIndex[i] = i;
+        std::sort(ordered.rankToIndex.begin(), ordered.rankToIndex.end(), [&](int left, int right){
+            int leftDegree = undirectedGraph.outDegree(left);
+            int rightDegree = undirectedGraph.outDegree(right);
+            if(leftDegree != rightDegree) return leftDegree < rightDegree;
+            return left < right;
+        });
+
+        std::vector<int> indexToRank(V);
+        for(int rank = 0; rank < V; rank++) indexToRank[ordered.rankToIndex[rank]] = rank;
+
+        ordered.degree.resize(V);
+        ordered.higherOffsets.assign(V + 1, 0);
+        ordered.lowerOffsets.assign(V + 1, 0);
+        for(int rank = 0; rank < V; rank++){
+            int i = ordered.rankToIndex[rank];
+            ordered.degree[rank] = undirectedGraph.outDegree(i);
+            for(int e = undirectedGraph.offsets[i]; e < undirectedGraph.offsets[i+1]; e++){
+                if(indexToRank[undirectedGraph.targets[e]] > rank) ordered.higherOffsets[rank+1]++;
+                else ordered.lowerOffsets[rank+1]++;
+            }
+        }
+        for(int rank = 0; rank < V; rank++){
+            ordered.higherOffsets[rank+1] += ordered.higherOffsets[rank];
+            ordered.lowerOffsets[rank+1] += ordered.lowerOffsets[rank];
+        }
+
+        ordered.higher.resize(ordered.higherOffsets[V]);
+        ordered.lower.resize(ordered.lowerOffsets[V]);
+        for(int rank = 0; rank < V; rank++){
+            int i = ordered.rankToIndex[rank];
+            int higherPosition = ordered.higherOffsets[rank];
+            int lowerPosition = ordered.lowerOffsets[rank];
+            for(int e = undirectedGraph.offsets[i]; e < undirectedGraph.offsets[i+1]; e++){
+                int neighborRank = indexToRank[undirectedGraph.targets[e]];
+                if(neighborRank > rank) ordered.higher[higherPosition++] = neighborRank;
+                else ordered.lower[lowerPosition++] = neighborRank;
+            }
+            std::sort(ordered.higher.begin() + ordered.higherOffsets[rank], ordered.higher.begin() + ordered.higherOffsets[rank+1]);
+            std::sort(ordered.lower.begin() + ordered.lowerOffsets[rank], ordered.lower.begin() + ordered.lowerOffsets[rank+1]);
+        }
+        return ordered;
+    }
+
+    /*
+        Size of the intersection of two sorted, duplicate free lists.
+
+        The vectorized paths compare a whole block of a against every rotation of a block of b
+        (8x8 with AVX2, 4x4 with SSE2), then advance whichever block ends with the smaller value.
+        The leftovers fall through to the usual scalar merge.
+    */
+    template <class T>
+    long long Clustering<T>::intersectionSize(const int* a, int aSize, const int* b, int bSize){
+        long long count = 0;
+        int i = 0, j = 0;
+
+#if defined(__AVX2__)
+        const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        while(i + 8 <= aSize && j + 8 <= bSize){
+            __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+
+            __m256i matches = _mm256_cmpeq_epi32(blockA, blockB);
+            for(int r = 1; r < 8; r++){
+                blockB = _mm256_permutevar8x32_epi32(blockB, rotate);
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(blockA, blockB));
+            }
+            count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(matches)));
+
+            int lastA = a[i+7], lastB = b[j+7];
+            if(lastA <= lastB) i += 8;
+            if(lastB <= lastA) j += 8;
+        }
+#elif defined(__SSE2__)
+        while(i + 4 <= aSize && j + 4 <= bSize){
+            __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+
+            __m128i matches = _mm_cmpeq_epi32(blockA, blockB);
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(0, 3, 2, 1))));
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(1, 0, 3, 2))));
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(2, 1, 0, 3))));
+            count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(matches)));
+
+            int lastA = a[i+3], lastB = b[j+3];
+            if(lastA <= lastB) i += 4;
+            if(lastB <= lastA) j += 4;
+        }
+#endif
+
+        while(i < aSize && j < bSize){
+            if(a[i] < b[j]) i++;
+            else if(b[j] < a[i]) j++;
+            else{
+                count++;
+                i++;
+                j++;
+            }
+        }
+        return count;
+    }
+}
+
+#endif // CLUSTERING_HPP
@@ -0,0 +1,278 @@
+#ifndef COMPRESSEDGRAPH_HPP
+#define COMPRESSEDGRAPH_HPP
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "Node/Node.hpp"
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+
+namespace Graphify{
+
+    template <class T>
+    class Node;
+
+    template <class T>
+    class Graph;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        A compressed sparse row (CSR) snapshot of a Graph or WeightedGraph.
+
+        Every node gets a dense index in [0, size()), and the neighbors of node i are
+        targets[offsets[i]] .. targets[offsets[i+1]-1] (with matching weights for weighted graphs).
+        The heavy algorithms work on this form because the map-based graphs need a tree
+        lookup per neighbor access, while here the adjacency is one contiguous array.
+
+        The snapshot does not follow later changes to the graph it was built from. W is the weight
+        type of the WeightedGraph it snapshots, and since the weights are their own array a 16 bit W
+        takes an edge from 8 bytes down to 6.
+    */
+    template <class T, class W = int>
+    class CompressedGraph{
+        public:
+            CompressedGraph();
+            CompressedGraph(Graph<T>& graph);
+            CompressedGraph(WeightedGraph<T, W>& graph);
+
+            int size();
+            int numEdges();
+            int outDegree(int i);
+            bool isWeighted();
+            W minWeight(); // both are 0 for unweighted or edgeless graphs
+            W maxWeight();
+
+            int index(Node<T>* node); // => -1 if the node isn't in the graph
+
+            CompressedGraph<T, W> transposed();
+            CompressedGraph<T, W> undirected(); // symmetric, sorted, no self loops, parallel edges keep their lightest weight
+            CompressedGraph<T, W> unitWeighted(); // every edge weighs 1, so the weighted algorithms can run on a snapshot of a Graph
+            void sortNeighbors();
+
+            std::vector<int> offsets;
+            std::vector<int> targets;
+            std::vector<W> weights; // empty for unweighted graphs
+
+            std::vector<Node<T>*> nodes; // index => node
+            std::map<Node<T>*, int> nodeToIndex;
+
+        private:
+            bool weighted;
+            W minEdgeWeight;
+            W maxEdgeWeight;
+
+            int addIndex(Node<T>* node);
+            void buildFromEdges(std::vector<int>& sources, std::vector<int>& edgeTargets, std::vector<W>& edgeWeights);
+    };
+
+    template <class T, class W>
+    CompressedGraph<T, W>::CompressedGraph()
+    : offsets({0}), weighted(false), minEdgeWeight(0), maxEdgeWeight(0)
+    { }
+
+    template <class T, class W>
+    CompressedGraph<T, W>::CompressedGraph(Graph<T>& graph)
+    : weighted(false), minEdgeWeight(0), maxEdgeWeight(0)
+    {
+        std::vector<int> sources, edgeTargets;
+        std::vector<W> edgeWeights;
+
+        // nodes with an adjacency list first, so their indices follow the graph's own order..
+        for(auto it = graph.begin(); it != graph.end(); it++) addIndex(it->first);
+
+        for(auto it = graph.begin(); it != graph.end(); it++){
+            int source = nodeToIndex[it->first];
+            for(auto baseNode : it->second){
+                sources.push_back(source);
+                edgeTargets.push_back(addIndex(baseNode)); // ..then nodes that only ever appear as targets
+            }
+        }
+        buildFromEdges(sources, edgeTargets, edgeWeights);
+    }
+
+    template <class T, class W>
+    CompressedGraph<T, W>::CompressedGraph(WeightedGraph<T, W>& graph)
+    : weighted(true), minEdgeWeight(0), maxEdgeWeight(0)
+    {
+        std::vector<int> sources, edgeTargets;
+        std::vector<W> edgeWeights;
+
+        for(auto it = graph.begin(); it != graph.end(); it++) addIndex(it->first);
+
+        for(auto it = graph.begin(); it != graph.end(); it++){
+            int source = nodeToIndex[it->first];
+            for(auto [baseNode, weight] : it->second){
+                sources.push_back(source);
+                edgeTargets.push_back(addIndex(baseNode));
+                edgeWeights.push_back(weight);
+            }
+        }
+        buildFromEdges(sources, edgeTargets, edgeWeights);
+    }
+
+    template <class T, class W>
+    int CompressedGraph<T, W>::size(){
+        return int(nodes.size());
+    }
+
+    template <class T, class W>
+    int CompressedGraph<T, W>::numEdges(){
+        return int(targets.size());
+    }
+
+    template <class T, class W>
+    int CompressedGraph<T, W>::outDegree(int i){
+        return offsets[i+1] - offsets[i];
+    }
+
+    template <class T, class W>
+    bool CompressedGraph<T, W>::isWeighted(){
+        return weighted;
+    }
+
+    template <class T, class W>
+    W CompressedGraph<T, W>::minWeight(){
+        return minEdgeWeight;
+    }
+
+    template <class T, class W>
+    W CompressedGraph<T, W>::maxWeight(){
+        return maxEdgeWeight;
+    }
+
+    template <class T, class W>
+    int CompressedGraph<T, W>::index(Node<T>* node){
+        auto it = nodeToIndex.find(node);
+        if(it == nodeToIndex.end()) return -1;
+        return it->second;
+    }
+
+    template <class T, class W>
+    CompressedGraph<T, W> CompressedGraph<T, W>::transposed(){
+        CompressedGraph<T, W> transposedGraph;
+        transposedGraph.nodes = nodes;
+        transposedGraph.nodeToIndex = nodeToIndex;
+        transposedGraph.weighted = weighted;
+
+        std::vector<int> sources, edgeTargets;
+        for(int i = 0; i < size(); i++){
+            for(int e = offsets[i]; e < offsets[i+1]; e++){
+                sources.push_back(targets[e]);
+                edgeTargets.push_back(i);
+            }
+        }
+        transposedGraph.buildFromEdges(sources, edgeTargets, weights); // edge e keeps its weight, just reversed
+        return transposedGraph;
+    }
+
+    template <class T, class W>
+    CompressedGraph<T, W> CompressedGraph<T, W>::undirected(){
+        CompressedGraph<T, W> undirectedGraph;
+        undirectedGraph.nodes = nodes;
+        undirectedGraph.nodeToIndex = nodeToIndex;
+        undirectedGraph.weighted = weighted;
+
+        std::vector<int> sources, edgeTargets;
+        std::vector<W> edgeWeights;
+        for(int i = 0; i < size(); i++){
+            for(int e = offsets[i]; e < offsets[i+1]; e++){
+                if(targets[e] == i) continue; // self loops never close a triangle or shorten a path..
+                sources.push_back(i);
+                edgeTargets.push_back(targets[e]);
+                sources.push_back(targets[e]);
+                edgeTargets.push_back(i);
+                if(weighted){
+                    edgeWeights.push_back(weights[e]);
+                    edgeWeights.push_back(weights[e]);
+                }
+            }
+        }
+        undirectedGraph.buildFromEdges(sources, edgeTargets, edgeWeights);
+        undirectedGraph.sortNeighbors();
+
+        // drop the parallel edges the symmetrization created.. rows are sorted by (target, weight), so the first copy is the lightest
+        std::vector<int> uniqueOffsets(undirectedGraph.size() + 1, 0);
+        int k = 0;
+        for(int i = 0; i < undirectedGraph.size(); i++){
+            int rowBegin = undirectedGraph.offsets[i];
+            int rowEnd = undirectedGraph.offsets[i+1];
+            uniqueOffsets[i] = k;
+            for(int e = rowBegin; e < rowEnd; e++){
+                if(e > rowBegin && undirectedGraph.targets[e] == undirectedGraph.targets[e-1]) continue;
+                if(weighted) undirectedGraph.weights[k] = undirectedGraph.weights[e];
+                undirectedGraph.targets[k++] = undirectedGraph.targets[e];
+            }
+        }
+        uniqueOffsets[undirectedGraph.size()] = k;
+        undirectedGraph.targets.resize(k);
+        if(weighted) undirectedGraph.weights.resize(k);
+        undirectedGraph.offsets = uniqueOffsets;
+
+        return undirectedGraph;
+    }
+
+    template <class T, class W>
+    CompressedGraph<T, W> CompressedGraph<T, W>::unitWeighted(){
+        CompressedGraph<T, W> unitWeightedGraph = *this;
+        unitWeightedGraph.weights.assign(targets.size(), W(1));
+        unitWeightedGraph.weighted = true;
+        unitWeightedGraph.minEdgeWeight = targets.empty() ? W(0) : W(1);
+        unitWeightedGraph.maxEdgeWeight = unitWeightedGraph.minEdgeWeight;
+        return unitWeightedGraph;
+    }
+
+    template <class T, class W>
+    void CompressedGraph<T, W>::sortNeighbors(){
+        for(int i = 0; i < size(); i++){
+            if(!weighted){
+                std::sort(targets.begin() + offsets[i], targets.begin() + offsets[i+1]);
+                continue;
+            }
+            std::vector<std::pair<int, W>> row;
+            for(int e = offsets[i]; e < offsets[i+1]; e++) row.push_back({targets[e], weights[e]});
+            std::sort(row.begin(), row.end());
+            for(int e = offsets[i]; e < offsets[i+1]; e++){
+                targets[e] = row[e - offsets[i]].first;
+                weights[e] = row[e - offsets[i]].second;
+            }
+        }
+    }
+
+    template <class T, class W>
+    int CompressedGraph<T, W>::addIndex(Node<T>* node){
+        auto it = nodeToIndex.find(node);
+        if(it != nodeToIndex.end()) return it->second;
+
+        int i = int(nodes.size());
+        nodes.push_back(node);
+        nodeToIndex.insert(std::make_pair(node, i));
+        return i;
+    }
+
+    // counting sort of the edges by source, which keeps each source's edges in their original order
+    template <class T, class W>
+    void CompressedGraph<T, W>::buildFromEdges(std::vector<int>& sources, std::vector<int>& edgeTargets, std::vector<W>& edgeWeights){
+        offsets.assign(size() + 1, 0);
+        for(auto source : sources) offsets[source+1]++;
+        for(int i = 0; i < size(); i++) offsets[i+1] += offsets[i];
+
+        targets.assign(sources.size(), 0);
+        weights.assign(edgeWeights.size(), 0);
+
+        std::vector<int> position(offsets.begin(), offsets.end() - 1);
+        for(size_t e = 0; e < sources.size(); e++){
+            int k = position[sources[e]]++;
+            targets[k] = edgeTargets[e];
+            if(weighted) weights[k] = edgeWeights[e];
+        }
+
+        // cached since the integer shortest path queues are picked by the weight range
+        minEdgeWeight = weights.empty() ? 0 : *std::min_element(weights.begin(), weights.end());
+        maxEdgeWeight = weights.empty() ? 0 : *std::max_element(weights.begin(), weights.end());
+    }
+}
+
+#endif // COMPRESSEDGRAPH_HPP
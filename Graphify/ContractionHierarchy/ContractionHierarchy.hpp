@@ -0,0 +1,628 @@
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "IndexedHeap/IndexedHeap.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include <map>
+#include <queue>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+namespace Graphify{
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        Contraction hierarchies (Geisberger et al.) for many point-to-point queries on a static graph
+        with non-negative weights.
+
+        Preprocessing contracts the nodes one at a time, least important first: a node is removed
+        and a shortcut u -> w is added for each pair of its neighbors whose only shortest path ran
+        through it (checked with a small "witness" Dijkstra). Importance is the edge difference
+        (shortcuts added - edges removed) plus the number of already contracted neighbors, which
+        spreads the contraction evenly over the graph. The contraction order is the node's rank.
+
+        A query is then a bidirectional Dijkstra where both sides only ever go up in rank, which
+        settles a few hundred nodes even on road networks with millions. Shortcuts remember the node
+        they skip, so the real path is recovered by unpacking them recursively. Shortcut weights and
+        distances are kept in WeightTraits<W>::Distance, a chain of uint16_t edges easily outgrows W.
+
+        The hierarchy is tied to the CSR numbering of the graph it was built from. save() writes it
+        to a file and load() reads it back against the same graph, skipping the preprocessing. The
+        file carries a fingerprint of that graph (which needs std::hash<T> and std::hash<W>), so load() refuses a
+        graph whose nodes, edges or weights differ, or whose node pointers now sort differently.
+        Queries reuse scratch arrays, so one hierarchy shouldn't be queried from two threads at once.
+    */
+    template <class T, class W = int>
+    class ContractionHierarchy{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            ContractionHierarchy(); // empty, for load()
+            ContractionHierarchy(CompressedGraph<T, W>& graph);
+            ContractionHierarchy(WeightedGraph<T, W>& graph);
+
+            std::tuple<Distance, std::vector<Node<T>*>> shortestPath(Node<T>* start, Node<T>* end); // => {-1, {}} if there's no path
+            Distance distance(Node<T>* start, Node<T>* end); // skips the unpacking, => -1 if there's no path
+
+            int size();
+            int numShortcuts();
+            int rank(Node<T>* node); // contraction order, => -1 if the node isn't in the hierarchy
+
+            bool save(std::string fileName);
+            bool load(std::string fileName, CompressedGraph<T, W>& graph); // => false (and unchanged) if the file is broken or was built from another graph
+            bool load(std::string fileName, WeightedGraph<T, W>& graph);
+
+        private:
+            struct Arc{
+                int node;
+                Distance weight; // a shortcut's weight is a sum of edges, which can outgrow W
+                int middle; // the contracted node a shortcut skips, -1 for original edges
+            };
+
+            // witness searches give up after settling this many nodes.. a missed witness only costs an unneeded shortcut.
+            // Priorities are only estimates, so simulated contractions get a much smaller budget.
+            static const int MAX_WITNESS_SETTLED = 500;
+            static const int MAX_SIMULATED_WITNESS_SETTLED = 50;
+
+            std::vector<int> nodeRank;
+            int shortcutCount;
+
+            // of the graph it was built from, checked by load()
+            int64_t graphEdges;
+            uint64_t graphFingerprint;
+
+            // upward[v]: v -> w with rank[w] > rank[v]. downward[v]: u -> v with rank[u] > rank[v], stored at v for the backward search
+            std::vector<int> upwardOffsets, downwardOffsets;
+            std::vector<Arc> upwardArcs, downwardArcs;
+
+            std::vector<Node<T>*> nodes;
+            std::map<Node<T>*, int> nodeToIndex;
+
+            // query scratch, all unreachable() / -1 between queries
+            std::vector<Distance> forwardDistance, backwardDistance;
+            std::vector<int> forwardPrevious, backwardNext;
+            std::vector<int> forwardMiddle, backwardMiddle;
+            std::vector<int> touchedNodes;
+            IndexedHeap<Distance> forwardNodesToVisit, backwardNodesToVisit;
+
+            void build(CompressedGraph<T, W>& graph);
+            int contract(int v, bool apply, std::vector<std::vector<Arc>>& outArcs, std::vector<std::vector<Arc>>& inArcs,
+                         std::vector<Distance>& witnessDistance, std::vector<int>& witnessTouched, IndexedHeap<Distance>& witnessNodesToVisit);
+            void addArc(std::vector<std::vector<Arc>>& outArcs, std::vector<std::vector<Arc>>& inArcs, int u, int w, Distance weight, int middle);
+            void bindNodes(CompressedGraph<T, W>& graph);
+            uint64_t fingerprint(CompressedGraph<T, W>& graph);
+            void resetScratch();
+
+            Distance query(int source, int target, int& meetingNode);
+            int findMiddle(int u, int w);
+            void unpackArc(int u, int w, int middle, std::vector<int>& path);
+    };
+
+    template <class T, class W>
+    ContractionHierarchy<T, W>::ContractionHierarchy()
+    : shortcutCount(0), graphEdges(0), graphFingerprint(0)
+    { }
+
+    template <class T, class W>
+    ContractionHierarchy<T, W>::ContractionHierarchy(CompressedGraph<T, W>& graph)
+    : shortcutCount(0), graphEdges(0), graphFingerprint(0)
+    {
+        build(graph);
+    }
+
+    template <class T, class W>
+    ContractionHierarchy<T, W>::ContractionHierarchy(WeightedGraph<T, W>& graph)
+    : shortcutCount(0), graphEdges(0), graphFingerprint(0)
+    {
+        CompressedGraph<T, W> compressedGraph(graph);
+        build(compressedGraph);
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> ContractionHierarchy<T, W>::shortestPath(Node<T>* start, Node<T>* end){
+        auto startIt = nodeToIndex.find(start);
+        auto endIt = nodeToIndex.find(end);
+        if(startIt == nodeToIndex.end() || endIt == nodeToIndex.end()) return { -1, {}};
+
+        int meetingNode = -1;
+        Distance length = query(startIt->second, endIt->second, meetingNode);
+        if(length == -1){
+            resetScratch();
+            return { -1, {}};
+        }
+
+        // up to the meeting node with the forward parents, then down with the backward ones, unpacking every arc on the way
+        std::vector<int> upwardPath;
+        for(int v = meetingNode; v != -1; v = forwardPrevious[v]) upwardPath.push_back(v);
+        std::reverse(upwardPath.begin(), upwardPath.end());
+
+        std::vector<int> path = {upwardPath[0]};
+        for(size_t i = 0; i + 1 < upwardPath.size(); i++) unpackArc(upwardPath[i], upwardPath[i+1], forwardMiddle[upwardPath[i+1]], path);
+        for(int v = meetingNode; backwardNext[v] != -1; v = backwardNext[v]) unpackArc(v, backwardNext[v], backwardMiddle[v], path);
+
+        resetScratch();
+
+        std::vector<Node<T>*> nodePath;
+        for(auto v : path) nodePath.push_back(nodes[v]);
+        return {length, nodePath};
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance ContractionHierarchy<T, W>::distance(Node<T>* start, Node<T>* end){
+        auto startIt = nodeToIndex.find(start);
+        auto endIt = nodeToIndex.find(end);
+        if(startIt == nodeToIndex.end() || endIt == nodeToIndex.end()) return -1;
+
+        int meetingNode = -1;
+        Distance length = query(startIt->second, endIt->second, meetingNode);
+        resetScratch();
+        return length;
+    }
+
+    template <class T, class W>
+    int ContractionHierarchy<T, W>::size(){
+        return int(nodes.size());
+    }
+
+    template <class T, class W>
+    int ContractionHierarchy<T, W>::numShortcuts(){
+        return shortcutCount;
+    }
+
+    template <class T, class W>
+    int ContractionHierarchy<T, W>::rank(Node<T>* node){
+        auto it = nodeToIndex.find(node);
+        if(it == nodeToIndex.end()) return -1;
+        return nodeRank[it->second];
+    }
+
+    template <class T, class W>
+    void ContractionHierarchy<T, W>::build(CompressedGraph<T, W>& graph){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return build(weightedGraph); }
+        int V = graph.size();
+        bindNodes(graph);
+        graphEdges = int64_t(graph.targets.size());
+        graphFingerprint = fingerprint(graph);
+
+        std::vector<std::vector<Arc>> outArcs(V), inArcs(V);
+        for(int u = 0; u < V; u++){
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++){
+                if(graph.targets[e] == u) continue; // self loops are never on a shortest path
+                addArc(outArcs, inArcs, u, graph.targets[e], graph.weights[e], -1);
+            }
+        }
+
+        std::vector<char> contracted(V, 0);
+        std::vector<int> contractedNeighbors(V, 0);
+        std::vector<Distance> witnessDistance(V, WeightTraits<W>::unreachable());
+        std::vector<int> witnessTouched;
+        IndexedHeap<Distance> witnessNodesToVisit(V);
+
+        auto priority = [&](int v){
+            int removedArcs = int(outArcs[v].size() + inArcs[v].size()); // only arcs to uncontracted nodes are left
+            int shortcuts = contract(v, false, outArcs, inArcs, witnessDistance, witnessTouched, witnessNodesToVisit);
+            return shortcuts - removedArcs + contractedNeighbors[v];
+        };
+
+        // a popped node's priority is recomputed (lazy updates) and it's only contracted if it's still the smallest.
+        // Contracting a node also refreshes its neighbors, whose priorities it changed the most.
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> contractionOrder;
+        std::vector<int> currentPriority(V);
+        for(int v = 0; v < V; v++){
+            currentPriority[v] = priority(v);
+            contractionOrder.push({currentPriority[v], v});
+        }
+
+        nodeRank.assign(V, -1);
+        shortcutCount = 0;
+        int nextRank = 0;
+        std::vector<int> neighbors;
+        while(!contractionOrder.empty()){
+            auto [queuedPriority, v] = contractionOrder.top();
+            contractionOrder.pop();
+            if(contracted[v] || queuedPriority != currentPriority[v]) continue; // stale entry..
+
+            currentPriority[v] = priority(v);
+            if(!contractionOrder.empty() && currentPriority[v] > contractionOrder.top().first){
+                contractionOrder.push({currentPriority[v], v});
+                continue;
+            }
+
+            shortcutCount += contract(v, true, outArcs, inArcs, witnessDistance, witnessTouched, witnessNodesToVisit);
+            contracted[v] = 1;
+            nodeRank[v] = nextRank++;
+
+            // v keeps its arcs (all to higher ranks now), the neighbors forget theirs to v so later searches don't keep skipping them
+            neighbors.clear();
+            for(auto& arc : outArcs[v]){
+                auto& reverseArcs = inArcs[arc.node];
+                reverseArcs.erase(std::remove_if(reverseArcs.begin(), reverseArcs.end(), [v](Arc& reverseArc){ return reverseArc.node == v; }), reverseArcs.end());
+                neighbors.push_back(arc.node);
+            }
+            for(auto& arc : inArcs[v]){
+                auto& reverseArcs = outArcs[arc.node];
+                reverseArcs.erase(std::remove_if(reverseArcs.begin(), reverseArcs.end(), [v](Arc& reverseArc){ return reverseArc.node == v; }), reverseArcs.end());
+                neighbors.push_back(arc.node);
+            }
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+            for(auto w : neighbors){
+                contractedNeighbors[w]++;
+                currentPriority[w] = priority(w);
+                contractionOrder.push({currentPriority[w], w});
+            }
+        }
+
+        // what's left at each node goes up in rank: out arcs for the forward search, in arcs for the backward one
+        auto flatten = [&](std::vector<std::vector<Arc>>& lists, std::vector<int>& offsets, std::vector<Arc>& arcs){
+            offsets.assign(V + 1, 0);
+            for(int v = 0; v < V; v++) offsets[v+1] = offsets[v] + int(lists[v].size());
+            arcs.clear();
+            arcs.reserve(offsets[V]);
+            for(auto& list : lists) arcs.insert(arcs.end(), list.begin(), list.end());
+        };
+        flatten(outArcs, upwardOffsets, upwardArcs);
+        flatten(inArcs, downwardOffsets, downwardArcs);
+    }
+
+    /*
+        Contracting v: for every remaining in-neighbor u, a witness Dijkstra from u that avoids v
+        looks for a path to each remaining out-neighbor w that's no longer than u -> v -> w. Where
+        there is none, u -> w needs a shortcut. With apply false it only counts them.
+    */
+    template <class T, class W>
+    int ContractionHierarchy<T, W>::contract(int v, bool apply, std::vector<std::vector<Arc>>& outArcs, std::vector<std::vector<Arc>>& inArcs,
+                                          std::vector<Distance>& witnessDistance, std::vector<int>& witnessTouched, IndexedHeap<Distance>& witnessNodesToVisit){
+        int shortcuts = 0;
+        std::vector<Arc> shortcutArcs; // added after the loop, inArcs[v] / outArcs[v] must not move while we iterate them
+        std::vector<int> shortcutSources;
+
+        for(auto& in : inArcs[v]){
+            int u = in.node;
+
+            Distance maxLength = -1;
+            for(auto& out : outArcs[v]){
+                if(out.node == u) continue;
+                maxLength = std::max(maxLength, in.weight + out.weight);
+            }
+            if(maxLength == -1) continue; // nothing on the other side of v
+
+            witnessDistance[u] = 0;
+            witnessTouched.push_back(u);
+            witnessNodesToVisit.push(u, 0);
+            int settledCount = 0;
+            int maxSettled = apply ? MAX_WITNESS_SETTLED : MAX_SIMULATED_WITNESS_SETTLED;
+
+            while(!witnessNodesToVisit.empty() && witnessNodesToVisit.topKey() <= maxLength && settledCount < maxSettled){
+                int x = witnessNodesToVisit.pop();
+                settledCount++;
+                for(auto& arc : outArcs[x]){
+                    if(arc.node == v) continue;
+                    Distance newDistance = witnessDistance[x] + arc.weight;
+                    if(newDistance >= witnessDistance[arc.node]) continue;
+                    if(witnessDistance[arc.node] == WeightTraits<W>::unreachable()) witnessTouched.push_back(arc.node);
+                    witnessDistance[arc.node] = newDistance;
+                    witnessNodesToVisit.pushOrDecrease(arc.node, newDistance);
+                }
+            }
+
+            for(auto& out : outArcs[v]){
+                int w = out.node;
+                if(w == u) continue;
+                if(witnessDistance[w] <= in.weight + out.weight) continue; // witness found
+
+                shortcuts++;
+                if(apply){
+                    shortcutSources.push_back(u);
+                    shortcutArcs.push_back({w, in.weight + out.weight, v});
+                }
+            }
+
+            witnessNodesToVisit.clear();
+            for(auto x : witnessTouched) witnessDistance[x] = WeightTraits<W>::unreachable();
+            witnessTouched.clear();
+        }
+
+        for(size_t i = 0; i < shortcutArcs.size(); i++) addArc(outArcs, inArcs, shortcutSources[i], shortcutArcs[i].node, shortcutArcs[i].weight, shortcutArcs[i].middle);
+        return shortcuts;
+    }
+
+    // parallel arcs collapse into the lightest one
+    template <class T, class W>
+    void ContractionHierarchy<T, W>::addArc(std::vector<std::vector<Arc>>& outArcs, std::vector<std::vector<Arc>>& inArcs, int u, int w, Distance weight, int middle){
+        for(auto& arc : outArcs[u]){
+            if(arc.node != w) continue;
+            if(weight < arc.weight){
+                arc.weight = weight;
+                arc.middle = middle;
+                for(auto& reverseArc : inArcs[w]){
+                    if(reverseArc.node != u) continue;
+                    reverseArc.weight = weight;
+                    reverseArc.middle = middle;
+                }
+            }
+            return;
+        }
+        outArcs[u].push_back({w, weight, middle});
+        inArcs[w].push_back({u, weight, middle});
+    }
+
+    template <class T, class W>
+    void ContractionHierarchy<T, W>::bindNodes(CompressedGraph<T, W>& graph){
+        nodes = graph.nodes;
+        nodeToIndex = graph.nodeToIndex;
+
+        int V = graph.size();
+        forwardDistance.assign(V, WeightTraits<W>::unreachable());
+        backwardDistance.assign(V, WeightTraits<W>::unreachable());
+        forwardPrevious.assign(V, -1);
+        backwardNext.assign(V, -1);
+        forwardMiddle.assign(V, -1);
+        backwardMiddle.assign(V, -1);
+        touchedNodes.clear();
+        forwardNodesToVisit.resize(V);
+        backwardNodesToVisit.resize(V);
+    }
+
+    /*
+        Node i's data, mixed with i, plus its out-edges as {target's data, weight}. The edges are summed,
+        so their order in the adjacency list doesn't matter, but which node got which CSR index does.
+    */
+    template <class T, class W>
+    uint64_t ContractionHierarchy<T, W>::fingerprint(CompressedGraph<T, W>& graph){
+        auto mix = [](uint64_t x){ // splitmix64's finalizer
+            x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        };
+        std::hash<T> dataHash;
+        std::hash<W> weightHash;
+
+        uint64_t h = mix(uint64_t(graph.targets.size()));
+        for(int v = 0; v < graph.size(); v++){
+            uint64_t edges = 0;
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                edges += mix(mix(dataHash(graph.nodes[graph.targets[e]]->data)) ^ uint64_t(weightHash(graph.weights[e])));
+            }
+            h = mix(h ^ mix(dataHash(graph.nodes[v]->data) + uint64_t(v))) + edges;
+        }
+        return h;
+    }
+
+    template <class T, class W>
+    void ContractionHierarchy<T, W>::resetScratch(){
+        for(auto v : touchedNodes){
+            forwardDistance[v] = backwardDistance[v] = WeightTraits<W>::unreachable();
+            forwardPrevious[v] = backwardNext[v] = -1;
+        }
+        touchedNodes.clear();
+        forwardNodesToVisit.clear();
+        backwardNodesToVisit.clear();
+    }
+
+    /*
+        Both searches only follow arcs up in rank, so neither can stop at the first meeting like a
+        plain bidirectional Dijkstra. Each side just runs until its queue top can't beat the best
+        length so far. The highest ranked node of the shortest path is settled by both sides.
+    */
+    template <class T, class W>
+    typename WeightTraits<W>::Distance ContractionHierarchy<T, W>::query(int source, int target, int& meetingNode){
+        const Distance UNREACHABLE = WeightTraits<W>::unreachable();
+        Distance bestLength = UNREACHABLE;
+        meetingNode = -1;
+
+        forwardDistance[source] = 0;
+        backwardDistance[target] = 0;
+        touchedNodes.push_back(source);
+        touchedNodes.push_back(target);
+        forwardNodesToVisit.push(source, 0);
+        backwardNodesToVisit.push(target, 0);
+
+        auto settleNext = [&](IndexedHeap<Distance>& nodesToVisit, std::vector<int>& offsets, std::vector<Arc>& arcs, std::vector<Distance>& distance, std::vector<int>& previous, std::vector<int>& middle, std::vector<Distance>& otherDistance){
+            int v = nodesToVisit.pop();
+            if(otherDistance[v] != UNREACHABLE && distance[v] + otherDistance[v] < bestLength){
+                bestLength = distance[v] + otherDistance[v];
+                meetingNode = v;
+            }
+
+            for(int e = offsets[v]; e < offsets[v+1]; e++){
+                int w = arcs[e].node;
+                Distance newDistance = distance[v] + arcs[e].weight;
+                if(newDistance >= distance[w]) continue;
+                if(forwardDistance[w] == UNREACHABLE && backwardDistance[w] == UNREACHABLE) touchedNodes.push_back(w);
+                distance[w] = newDistance;
+                previous[w] = v;
+                middle[w] = arcs[e].middle;
+                nodesToVisit.pushOrDecrease(w, newDistance);
+            }
+        };
+
+        while(true){
+            bool forwardDone = forwardNodesToVisit.empty() || forwardNodesToVisit.topKey() >= bestLength;
+            bool backwardDone = backwardNodesToVisit.empty() || backwardNodesToVisit.topKey() >= bestLength;
+            if(forwardDone && backwardDone) break;
+
+            if(!forwardDone && (backwardDone || forwardNodesToVisit.topKey() <= backwardNodesToVisit.topKey())){
+                settleNext(forwardNodesToVisit, upwardOffsets, upwardArcs, forwardDistance, forwardPrevious, forwardMiddle, backwardDistance);
+            }
+            else settleNext(backwardNodesToVisit, downwardOffsets, downwardArcs, backwardDistance, backwardNext, backwardMiddle, forwardDistance);
+        }
+
+        if(meetingNode == -1) return -1;
+        return bestLength;
+    }
+
+    // the middle of the stored arc u -> w, which lives at whichever end has the lower rank
+    template <class T, class W>
+    int ContractionHierarchy<T, W>::findMiddle(int u, int w){
+        if(nodeRank[w] > nodeRank[u]){
+            for(int e = upwardOffsets[u]; e < upwardOffsets[u+1]; e++) if(upwardArcs[e].node == w) return upwardArcs[e].middle;
+        }
+        else{
+            for(int e = downwardOffsets[w]; e < downwardOffsets[w+1]; e++) if(downwardArcs[e].node == u) return downwardArcs[e].middle;
+        }
+        return -1;
+    }
+
+    // appends the original nodes of arc u -> w after u (u itself is already on the path)
+    template <class T, class W>
+    void ContractionHierarchy<T, W>::unpackArc(int u, int w, int middle, std::vector<int>& path){
+        std::vector<std::tuple<int, int, int>> arcsToUnpack = {{u, w, middle}}; // stack, so deep shortcut chains can't overflow
+        while(!arcsToUnpack.empty()){
+            auto [from, to, via] = arcsToUnpack.back();
+            arcsToUnpack.pop_back();
+            if(via == -1){
+                path.push_back(to);
+                continue;
+            }
+            arcsToUnpack.push_back({via, to, findMiddle(via, to)}); // second half goes on first so the first half comes out first
+            arcsToUnpack.push_back({from, via, findMiddle(from, via)});
+        }
+    }
+
+    /*
+        Binary file: a magic tag, the node count, shortcut count and Distance type, the graph's edge
+        count and fingerprint, the ranks and both arc arrays (nodes and middles, then the weights). Node pointers can't be stored, so load() takes the graph again, checks it
+        against the fingerprint and rebinds the CSR indices to its nodes.
+    */
+    template <class T, class W>
+    bool ContractionHierarchy<T, W>::save(std::string fileName){
+        std::ofstream file(fileName, std::ios::binary);
+        if(!file) return false;
+
+        auto writeValues = [&](const auto& values){ // ints or Distances
+            int64_t count = int64_t(values.size());
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            file.write(reinterpret_cast<const char*>(values.data()), count * sizeof(values[0]));
+        };
+        auto writeInts = [&](const std::vector<int>& values){ writeValues(values); };
+        auto writeArcs = [&](const std::vector<Arc>& arcs){ // {node, middle} pairs, then the weights
+            std::vector<int> values;
+            std::vector<Distance> weights;
+            values.reserve(arcs.size() * 2);
+            weights.reserve(arcs.size());
+            for(auto& arc : arcs){
+                values.push_back(arc.node);
+                values.push_back(arc.middle);
+                weights.push_back(arc.weight);
+            }
+            writeValues(values);
+            writeValues(weights);
+        };
+
+        file.write("GRC3", 4);
+        writeInts({int(nodes.size()), shortcutCount, int(std::is_floating_point<Distance>::value)});
+        file.write(reinterpret_cast<const char*>(&graphEdges), sizeof(graphEdges));
+        file.write(reinterpret_cast<const char*>(&graphFingerprint), sizeof(graphFingerprint));
+        writeInts(nodeRank);
+        writeInts(upwardOffsets);
+        writeArcs(upwardArcs);
+        writeInts(downwardOffsets);
+        writeArcs(downwardArcs);
+        return bool(file);
+    }
+
+    template <class T, class W>
+    bool ContractionHierarchy<T, W>::load(std::string fileName, CompressedGraph<T, W>& graph){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return load(fileName, weightedGraph); }
+        std::ifstream file(fileName, std::ios::binary);
+        if(!file) return false;
+        file.seekg(0, std::ios::end);
+        int64_t fileSize = int64_t(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        auto readValues = [&](auto& values){
+            int64_t count = 0;
+            file.read(reinterpret_cast<char*>(&count), sizeof(count));
+            // a count past what's left of the file is garbage, don't let it size the vector
+            if(!file || count < 0 || count > (fileSize - int64_t(file.tellg())) / int64_t(sizeof(values[0]))) return false;
+            values.resize(count);
+            file.read(reinterpret_cast<char*>(values.data()), count * sizeof(values[0]));
+            return bool(file);
+        };
+        auto readInts = [&](std::vector<int>& values){ return readValues(values); };
+        auto readArcs = [&](std::vector<Arc>& arcs){
+            std::vector<int> values;
+            std::vector<Distance> weights;
+            if(!readInts(values) || values.size() % 2 != 0 || !readValues(weights) || weights.size() != values.size() / 2) return false;
+            arcs.resize(weights.size());
+            for(size_t i = 0; i < arcs.size(); i++) arcs[i] = {values[2*i], weights[i], values[2*i+1]};
+            return true;
+        };
+
+        char magic[4];
+        file.read(magic, 4);
+        if(!file || std::string(magic, 4) != "GRC3") return false;
+
+        int V = graph.size();
+        std::vector<int> header;
+        if(!readInts(header) || header.size() != 3 || header[0] != V) return false;
+        if(header[2] != int(std::is_floating_point<Distance>::value)) return false; // saved with the other Distance type
+
+        int64_t edges = 0;
+        uint64_t savedFingerprint = 0;
+        file.read(reinterpret_cast<char*>(&edges), sizeof(edges));
+        file.read(reinterpret_cast<char*>(&savedFingerprint), sizeof(savedFingerprint));
+        if(!file || edges != int64_t(graph.targets.size()) || savedFingerprint != fingerprint(graph)) return false;
+
+        // read into locals and only swapped in once all of it checks out, a bad file leaves the hierarchy as it was
+        std::vector<int> rank, upOffsets, downOffsets;
+        std::vector<Arc> upArcs, downArcs;
+        if(!readInts(rank) || !readInts(upOffsets) || !readArcs(upArcs) || !readInts(downOffsets) || !readArcs(downArcs)) return false;
+
+        if(int(rank.size()) != V) return false;
+        std::vector<bool> rankTaken(V, false);
+        for(auto r : rank){
+            if(r < 0 || r >= V || rankTaken[r]) return false;
+            rankTaken[r] = true;
+        }
+
+        // both arc arrays only go up in rank and a shortcut's middle is below both of its ends,
+        // otherwise the queries wouldn't be exact and unpackArc could chase a cycle of middles forever
+        auto validCSR = [&](const std::vector<int>& offsets, const std::vector<Arc>& arcs){
+            if(int(offsets.size()) != V + 1 || offsets[0] != 0 || offsets[V] != int(arcs.size())) return false;
+            for(int v = 0; v < V; v++) if(offsets[v] > offsets[v+1]) return false;
+            for(int v = 0; v < V; v++){
+                for(int e = offsets[v]; e < offsets[v+1]; e++){
+                    auto& arc = arcs[e];
+                    if(arc.node < 0 || arc.node >= V || arc.middle < -1 || arc.middle >= V || !(arc.weight >= 0)) return false; // catches a NaN weight too
+                    if(rank[arc.node] <= rank[v]) return false;
+                    if(arc.middle != -1 && rank[arc.middle] >= rank[v]) return false;
+                }
+            }
+            return true;
+        };
+        if(!validCSR(upOffsets, upArcs) || !validCSR(downOffsets, downArcs)) return false;
+
+        nodeRank.swap(rank);
+        upwardOffsets.swap(upOffsets);
+        upwardArcs.swap(upArcs);
+        downwardOffsets.swap(downOffsets);
+        downwardArcs.swap(downArcs);
+        shortcutCount = header[1];
+        graphEdges = edges;
+        graphFingerprint = savedFingerprint;
+        bindNodes(graph);
+        return true;
+    }
+
+    template <class T, class W>
+    bool ContractionHierarchy<T, W>::load(std::string fileName, WeightedGraph<T, W>& graph){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return load(fileName, compressedGraph);
+    }
+}
+
+#endif // CONTRACTIONHIERARCHY_HPP
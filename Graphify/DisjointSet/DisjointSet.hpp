@@ -0,0 +1,70 @@
+#ifndef DISJOINTSET_HPP
+#define DISJOINTSET_HPP
+
+#include <vector>
+#include <utility>
+
+namespace Graphify{
+
+    /*
+        Union-find over dense ids 0 .. n-1, with union by rank and path halving
+        (every node on a find path is pointed at its grandparent), so any sequence
+        of operations costs O(alpha(n)) each, amortized.
+    */
+    class DisjointSet{
+        public:
+            DisjointSet(int n=0);
+
+            int find(int x);
+            bool unite(int x, int y); // => false if x and y were already in the same set
+            bool connected(int x, int y);
+
+            int size(); // number of ids
+            int numSets();
+
+        private:
+            std::vector<int> parent;
+            std::vector<unsigned char> rank; // a rank never gets past log2(n)
+            int sets;
+    };
+
+    inline DisjointSet::DisjointSet(int n)
+    : parent(n), rank(n, 0), sets(n)
+    {
+        for(int i = 0; i < n; i++) parent[i] = i;
+    }
+
+    inline int DisjointSet::find(int x){
+        while(parent[x] != x){
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    inline bool DisjointSet::unite(int x, int y){
+        x = find(x);
+        y = find(y);
+        if(x == y) return false;
+
+        if(rank[x] < rank[y]) std::swap(x, y);
+        parent[y] = x;
+        if(rank[x] == rank[y]) rank[x]++;
+        sets--;
+        return true;
+    }
+
+    inline bool DisjointSet::connected(int x, int y){
+        return find(x) == find(y);
+    }
+
+    inline int DisjointSet::size(){
+        return int(parent.size());
+    }
+
+    inline int DisjointSet::numSets(){
+        return sets;
+    }
+}
+
+#endif // DISJOINTSET_HPP
@@ -0,0 +1,334 @@
+#ifndef DYNAMICSHORTESTPATHTREE_HPP
+#define DYNAMICSHORTESTPATHTREE_HPP
+
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "WeightedTraversals/WeightedTraversals.hpp"
+#include "ShortestPathTree/ShortestPathTree.hpp"
+#include "IndexedHeap/IndexedHeap.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include "ErrorHandling/ErrorHandling.hpp"
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        A shortest path tree from one fixed source that is kept up to date as edges change, in the
+        spirit of Ramalingam & Reps. Instead of a new Dijkstra over the whole graph, an update only
+        touches the nodes whose distance can actually change:
+
+            lighter edge u -> v (or a new one)  =>  if it shortens v, a Dijkstra seeded with just v,
+                                                    which stops wherever distances stop improving
+            heavier tree edge u -> v            =>  v's subtree is cut loose, each node in it restarts
+                                                    from its best in-edge out of the rest of the tree,
+                                                    and a Dijkstra seeded with those settles the subtree
+            heavier non-tree edge               =>  nothing, no shortest path used it
+
+        Change the graph through setWeight/addEdge here, which forward to the graph. If the graph is
+        mutated some other way the tree notices (see mutationEpoch()) and rebuilds from scratch on
+        its next call, like ReachabilityIndex. Weights must be non-negative: a negative one is
+        reported and the update is dropped before it reaches the graph. W is the graph's weight
+        type and distances are WeightTraits<W>::Distance, like WeightedTraversals<T, W>.
+
+            DynamicShortestPathTree<int> tree(graph, depot);
+            tree.setWeight(a, b, 120); // a traffic update, only b's subtree is repaired
+            long long eta = tree.distanceTo(customer);
+    */
+    template <class T, class W = int>
+    class DynamicShortestPathTree{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            DynamicShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* source);
+
+            void setWeight(Node<T>* node, Node<T>* baseNode, W newWeight); // same edge WeightedGraph::setWeight picks
+            void addEdge(Node<T>* node, std::pair<Node<T>*, W> edge);
+
+            Node<T>* source();
+            bool isReachable(Node<T>* node);
+            Distance distanceTo(Node<T>* node); // => -1 if unreachable
+            Node<T>* parentOf(Node<T>* node); // => nullptr for the source and unreachable nodes
+            std::vector<Node<T>*> pathTo(Node<T>* node); // source .. node, {} if unreachable
+            ShortestPathTree<T, Distance> shortestPathTree(); // a copy of the tree as it is now
+
+            bool isStale(); // the graph was changed behind the tree's back
+            void rebuild();
+
+        private:
+            WeightedGraph<T, W>* graph;
+            Node<T>* sourceNode;
+            int sourceIndex;
+            size_t cachedEpoch;
+
+            std::vector<Node<T>*> nodes;
+            std::map<Node<T>*, int> nodeToIndex;
+            std::vector<std::vector<std::pair<int, W>>> outEdges; // {target, weight}, in the graph's own order
+            std::vector<std::vector<std::pair<int, W>>> inEdges; // {source, weight}
+
+            std::vector<Distance> nodeDistance; // WeightTraits<W>::unreachable() if unreachable
+            std::vector<int> previousNode; // -1 for the source and unreachable nodes
+
+            // kept between updates so a small repair doesn't pay O(V) to set them up
+            IndexedHeap<Distance> nodesToVisit;
+            int heapCapacity;
+            std::vector<char> affected;
+
+            void refresh(); // rebuilds if stale
+            int index(Node<T>* node); // => -1 if the tree hasn't seen the node
+            int addIndex(Node<T>* node);
+
+            void decrease(int u, int v, W weight); // u -> v got lighter or was added
+            void increase(int v); // v's tree edge got heavier
+            void propagate(); // Dijkstra from whatever the repair left in nodesToVisit
+    };
+
+    template <class T, class W>
+    DynamicShortestPathTree<T, W>::DynamicShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* source)
+    : graph(&graph), sourceNode(source), sourceIndex(-1), cachedEpoch(graph.mutationEpoch()), heapCapacity(0)
+    {
+        rebuild();
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::setWeight(Node<T>* node, Node<T>* baseNode, W newWeight){
+        ErrorHandling<T>().checkNonNegativeEdgeWeight(newWeight);
+        if(newWeight < 0) return;
+
+        refresh();
+
+        // no such edge.. checked first, WeightedGraph::setWeight would insert node as a key (without bumping the epoch)
+        int u = index(node);
+        int v = index(baseNode);
+        if(u == -1 || v == -1) return;
+        auto it = std::find_if(outEdges[u].begin(), outEdges[u].end(), [&](auto& edge){ return edge.first == v; });
+        if(it == outEdges[u].end()) return;
+
+        graph->setWeight(node, baseNode, newWeight);
+        cachedEpoch = graph->mutationEpoch();
+
+        // WeightedGraph::setWeight moves the edge to the back, so the next setWeight finds the same one as the graph does
+        W oldWeight = it->second;
+        outEdges[u].erase(it);
+        outEdges[u].push_back({v, newWeight});
+        for(auto& edge : inEdges[v]){
+            if(edge.first == u && edge.second == oldWeight){
+                edge.second = newWeight;
+                break;
+            }
+        }
+
+        if(newWeight < oldWeight) decrease(u, v, newWeight);
+        else if(newWeight > oldWeight && previousNode[v] == u) increase(v);
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::addEdge(Node<T>* node, std::pair<Node<T>*, W> edge){
+        ErrorHandling<T>().checkNonNegativeEdgeWeight(edge.second);
+        if(edge.second < 0) return;
+
+        refresh();
+
+        graph->addEdge(node, edge);
+        cachedEpoch = graph->mutationEpoch();
+
+        int u = addIndex(node);
+        int v = addIndex(edge.first);
+        outEdges[u].push_back({v, edge.second});
+        inEdges[v].push_back({u, edge.second});
+        decrease(u, v, edge.second);
+    }
+
+    template <class T, class W>
+    Node<T>* DynamicShortestPathTree<T, W>::source(){
+        return sourceNode;
+    }
+
+    template <class T, class W>
+    bool DynamicShortestPathTree<T, W>::isReachable(Node<T>* node){
+        refresh();
+        int i = index(node);
+        return i != -1 && nodeDistance[i] != WeightTraits<W>::unreachable();
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance DynamicShortestPathTree<T, W>::distanceTo(Node<T>* node){
+        if(!isReachable(node)) return -1;
+        return nodeDistance[index(node)];
+    }
+
+    template <class T, class W>
+    Node<T>* DynamicShortestPathTree<T, W>::parentOf(Node<T>* node){
+        refresh();
+        int i = index(node);
+        if(i == -1 || previousNode[i] == -1) return nullptr;
+        return nodes[previousNode[i]];
+    }
+
+    template <class T, class W>
+    std::vector<Node<T>*> DynamicShortestPathTree<T, W>::pathTo(Node<T>* node){
+        std::vector<Node<T>*> path;
+        if(!isReachable(node)) return path;
+
+        for(int currentBackTrackedNode = index(node); currentBackTrackedNode != -1; currentBackTrackedNode = previousNode[currentBackTrackedNode]){
+            path.push_back(nodes[currentBackTrackedNode]);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> DynamicShortestPathTree<T, W>::shortestPathTree(){
+        refresh();
+        ShortestPathTree<T, Distance> tree;
+        tree.sourceIndex = sourceIndex;
+        tree.nodeDistance = nodeDistance;
+        tree.previousNode = previousNode;
+        tree.nodes = nodes;
+        return tree;
+    }
+
+    template <class T, class W>
+    bool DynamicShortestPathTree<T, W>::isStale(){
+        return graph->mutationEpoch() != cachedEpoch;
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::rebuild(){
+        CompressedGraph<T, W> compressedGraph(*graph);
+        int V = compressedGraph.size();
+
+        nodes = compressedGraph.nodes;
+        nodeToIndex = compressedGraph.nodeToIndex;
+        outEdges.assign(V, {});
+        inEdges.assign(V, {});
+        for(int u = 0; u < V; u++){
+            for(int e = compressedGraph.offsets[u]; e < compressedGraph.offsets[u+1]; e++){
+                outEdges[u].push_back({compressedGraph.targets[e], compressedGraph.weights[e]});
+                inEdges[compressedGraph.targets[e]].push_back({u, compressedGraph.weights[e]});
+            }
+        }
+
+        WeightedTraversals<T, W> traversals;
+        auto tree = traversals.djikstraShortestPathTree(compressedGraph, sourceNode);
+        sourceIndex = tree.sourceIndex;
+        nodeDistance = tree.nodeDistance;
+        previousNode = tree.previousNode;
+
+        heapCapacity = std::max(V, 1);
+        nodesToVisit.resize(heapCapacity);
+        affected.assign(V, 0);
+        cachedEpoch = graph->mutationEpoch();
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::refresh(){
+        if(isStale()) rebuild();
+    }
+
+    template <class T, class W>
+    int DynamicShortestPathTree<T, W>::index(Node<T>* node){
+        auto it = nodeToIndex.find(node);
+        if(it == nodeToIndex.end()) return -1;
+        return it->second;
+    }
+
+    template <class T, class W>
+    int DynamicShortestPathTree<T, W>::addIndex(Node<T>* node){
+        int i = index(node);
+        if(i != -1) return i;
+
+        i = int(nodes.size());
+        nodes.push_back(node);
+        nodeToIndex.insert(std::make_pair(node, i));
+        outEdges.push_back({});
+        inEdges.push_back({});
+        nodeDistance.push_back(WeightTraits<W>::unreachable());
+        previousNode.push_back(-1);
+        affected.push_back(0);
+
+        if(node == sourceNode){ // the source only just showed up in the graph
+            sourceIndex = i;
+            nodeDistance[i] = 0;
+        }
+        if(i >= heapCapacity){ // doubling, so adding nodes one at a time stays amortized O(1)
+            heapCapacity *= 2;
+            nodesToVisit.resize(heapCapacity);
+        }
+        return i;
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::decrease(int u, int v, W weight){
+        if(nodeDistance[u] == WeightTraits<W>::unreachable()) return;
+
+        Distance candidate = nodeDistance[u] + weight;
+        if(candidate >= nodeDistance[v]) return;
+
+        nodeDistance[v] = candidate;
+        previousNode[v] = u;
+        nodesToVisit.pushOrDecrease(v, nodeDistance[v]);
+        propagate();
+    }
+
+    /*
+        Every node in v's subtree got to the source through the heavier edge, so all of them may get
+        further away (a superset of Ramalingam & Reps' affected set, which would also keep the nodes
+        with a second, equally short path.. finding those costs about as much as just resettling them).
+        Nothing outside the subtree can change: its paths don't use the edge, and no weight went down.
+    */
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::increase(int v){
+        std::vector<int> subtree = {v};
+        affected[v] = 1;
+        for(size_t i = 0; i < subtree.size(); i++){
+            int x = subtree[i];
+            for(auto [y, weight] : outEdges[x]){
+                if(affected[y] || previousNode[y] != x) continue;
+                affected[y] = 1;
+                subtree.push_back(y);
+            }
+        }
+
+        for(auto x : subtree){
+            nodeDistance[x] = WeightTraits<W>::unreachable();
+            previousNode[x] = -1;
+        }
+        for(auto x : subtree){
+            for(auto [y, weight] : inEdges[x]){
+                if(affected[y] || nodeDistance[y] == WeightTraits<W>::unreachable()) continue;
+                Distance candidate = nodeDistance[y] + weight;
+                if(candidate < nodeDistance[x]){
+                    nodeDistance[x] = candidate;
+                    previousNode[x] = y;
+                }
+            }
+            if(nodeDistance[x] != WeightTraits<W>::unreachable()) nodesToVisit.pushOrDecrease(x, nodeDistance[x]);
+        }
+        for(auto x : subtree) affected[x] = 0;
+
+        propagate();
+    }
+
+    template <class T, class W>
+    void DynamicShortestPathTree<T, W>::propagate(){
+        while(!nodesToVisit.empty()){
+            int currentNode = nodesToVisit.pop();
+            for(auto [neighbor, weight] : outEdges[currentNode]){
+                Distance newDistance = nodeDistance[currentNode] + weight;
+                if(newDistance < nodeDistance[neighbor]){
+                    nodeDistance[neighbor] = newDistance;
+                    previousNode[neighbor] = currentNode;
+                    nodesToVisit.pushOrDecrease(neighbor, nodeDistance[neighbor]);
+                }
+            }
+        }
+    }
+}
+
+#endif // DYNAMICSHORTESTPATHTREE_HPP
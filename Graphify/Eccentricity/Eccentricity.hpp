@@ -0,0 +1,314 @@
+#ifndef ECCENTRICITY_HPP
+#define ECCENTRICITY_HPP
+
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include <map>
+#include <queue>
+#include <tuple>
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T>
+    class Graph;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        Eccentricity, diameter and radius without all pairs distances.
+
+        By default edges are treated as undirected, and on a disconnected graph every node's
+        eccentricity is measured inside its own component (so the diameter is the largest component
+        diameter, and an isolated node has eccentricity 0). With directed = true distances follow
+        the edges, a node's eccentricity is its largest distance to any node it can reach, and the
+        components are the strongly connected ones. Weighted graphs expect non-negative weights, and
+        eccentricities come back in the weights' Distance type (long long, or double for floating point).
+
+        The radius is the smallest eccentricity over the whole graph, not per component, so an
+        isolated node (or, directed, a node without out-edges) makes it 0. For the radius of one
+        component, pass just that component.
+
+        Everything here is built on single source BFS (Dijkstra for weighted graphs) plus the
+        eccentricity bounds of Takes & Kosters: after a search from v, every node w in the component satisfies
+
+            max(ecc(v) - d(v, w), d(w, v)) <= ecc(w) <= ecc(v) + d(w, v)
+
+        so a handful of well chosen searches usually pins down the answer, using O(V) memory. On an
+        undirected graph d(w, v) = d(v, w) and one search gives both. A directed graph takes a forward
+        and a backward (transposed) search from v, and only nodes in v's strongly connected component
+        get bounds from them, since exactly those reach what v reaches. That makes directed mode
+        fastest on (mostly) strongly connected graphs- on a DAG every node needs its own searches.
+    */
+    template <class T, class W = int>
+    class Eccentricity{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            Distance diameter(Graph<T>& graph, bool directed=false);
+            Distance diameter(WeightedGraph<T, W>& graph, bool directed=false);
+
+            Distance radius(Graph<T>& graph, bool directed=false);
+            Distance radius(WeightedGraph<T, W>& graph, bool directed=false);
+
+            std::map<Node<T>*, Distance> eccentricities(Graph<T>& graph, bool directed=false);
+            std::map<Node<T>*, Distance> eccentricities(WeightedGraph<T, W>& graph, bool directed=false);
+
+            // {lower bounds, upper bounds} for every node after at most maxSearches single source searches (forward + backward counts as one)
+            std::tuple<std::map<Node<T>*, Distance>, std::map<Node<T>*, Distance>> eccentricityBounds(Graph<T>& graph, int maxSearches, bool directed=false);
+            std::tuple<std::map<Node<T>*, Distance>, std::map<Node<T>*, Distance>> eccentricityBounds(WeightedGraph<T, W>& graph, int maxSearches, bool directed=false);
+
+            // fast mode: {lower bound, upper bound} on the diameter after at most maxSearches searches (4 is usually tight)
+            std::tuple<Distance, Distance> approximateDiameter(Graph<T>& graph, int maxSearches=4, bool directed=false);
+            std::tuple<Distance, Distance> approximateDiameter(WeightedGraph<T, W>& graph, int maxSearches=4, bool directed=false);
+
+            // CSR version of all the above. Fills the per node bounds (by CSR index) and returns the number of searches used.
+            int boundEccentricities(CompressedGraph<T, W>& graph, bool forDiameter, bool forRadius, bool forAll, int maxSearches, std::vector<Distance>& lower, std::vector<Distance>& upper, bool directed=false);
+
+        private:
+            void singleSourceDistances(CompressedGraph<T, W>& graph, int source, std::vector<Distance>& distance, std::vector<int>& visitedNodes);
+
+            std::tuple<Distance, Distance> diameterBounds(CompressedGraph<T, W>& graph, int maxSearches, bool directed);
+            Distance exactRadius(CompressedGraph<T, W>& graph, bool directed);
+
+            std::tuple<std::map<Node<T>*, Distance>, std::map<Node<T>*, Distance>> nodeBounds(CompressedGraph<T, W>& graph, int maxSearches, bool directed);
+    };
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Eccentricity<T, W>::diameter(Graph<T>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return std::get<0>(diameterBounds(compressedGraph, INT_MAX, directed));
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Eccentricity<T, W>::diameter(WeightedGraph<T, W>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return std::get<0>(diameterBounds(compressedGraph, INT_MAX, directed));
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Eccentricity<T, W>::radius(Graph<T>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return exactRadius(compressedGraph, directed);
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Eccentricity<T, W>::radius(WeightedGraph<T, W>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return exactRadius(compressedGraph, directed);
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, typename WeightTraits<W>::Distance> Eccentricity<T, W>::eccentricities(Graph<T>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return std::get<0>(nodeBounds(compressedGraph, INT_MAX, directed)); // bounds meet when searches aren't capped
+    }
+
+    template <class T, class W>
+    std::map<Node<T>*, typename WeightTraits<W>::Distance> Eccentricity<T, W>::eccentricities(WeightedGraph<T, W>& graph, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return std::get<0>(nodeBounds(compressedGraph, INT_MAX, directed));
+    }
+
+    template <class T, class W>
+    std::tuple<std::map<Node<T>*, typename WeightTraits<W>::Distance>, std::map<Node<T>*, typename WeightTraits<W>::Distance>> Eccentricity<T, W>::eccentricityBounds(Graph<T>& graph, int maxSearches, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return nodeBounds(compressedGraph, maxSearches, directed);
+    }
+
+    template <class T, class W>
+    std::tuple<std::map<Node<T>*, typename WeightTraits<W>::Distance>, std::map<Node<T>*, typename WeightTraits<W>::Distance>> Eccentricity<T, W>::eccentricityBounds(WeightedGraph<T, W>& graph, int maxSearches, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return nodeBounds(compressedGraph, maxSearches, directed);
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, typename WeightTraits<W>::Distance> Eccentricity<T, W>::approximateDiameter(Graph<T>& graph, int maxSearches, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return diameterBounds(compressedGraph, maxSearches, directed);
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, typename WeightTraits<W>::Distance> Eccentricity<T, W>::approximateDiameter(WeightedGraph<T, W>& graph, int maxSearches, bool directed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return diameterBounds(compressedGraph, maxSearches, directed);
+    }
+
+    /*
+        Takes & Kosters' BoundingDiameters, run one component at a time.
+
+        A node stays a candidate while its bounds could still change the answers asked for
+        (diameter, radius or every eccentricity). Searches alternate between the candidate with
+        the largest upper bound and the one with the smallest lower bound, which in practice pulls
+        both ends of the diameter and the center together in a few searches. The first search of a
+        component doubles as finding its nodes, and the second starts from its highest degree node,
+        the usual guess for a central node.
+    */
+    template <class T, class W>
+    int Eccentricity<T, W>::boundEccentricities(CompressedGraph<T, W>& graph, bool forDiameter, bool forRadius, bool forAll, int maxSearches, std::vector<Distance>& lower, std::vector<Distance>& upper, bool directed){
+        // forward searches go over forwardGraph, backward ones over backwardGraph.. the same undirected view unless directed
+        CompressedGraph<T, W> undirectedGraph, reverseGraph;
+        if(directed) reverseGraph = graph.transposed();
+        else undirectedGraph = graph.undirected();
+        CompressedGraph<T, W>& forwardGraph = directed ? graph : undirectedGraph;
+        CompressedGraph<T, W>& backwardGraph = directed ? reverseGraph : undirectedGraph;
+        int V = graph.size();
+
+        const Distance UNBOUNDED = WeightTraits<W>::unreachable();
+        lower.assign(V, 0);
+        upper.assign(V, UNBOUNDED);
+
+        std::vector<Distance> forwardDistance(V, -1), backwardDistance(V, -1);
+        std::vector<int> forwardVisited, backwardVisited;
+        std::vector<char> seen(V, 0);
+
+        Distance diameterLower = 0;
+        Distance radiusUpper = UNBOUNDED;
+        int numSearches = 0;
+
+        auto search = [&](int v){
+            singleSourceDistances(forwardGraph, v, forwardDistance, forwardVisited);
+            if(directed) singleSourceDistances(backwardGraph, v, backwardDistance, backwardVisited);
+            numSearches++;
+        };
+        auto backward = [&](int w){ return directed ? backwardDistance[w] : forwardDistance[w]; }; // d(w, v)
+
+        for(int root = 0; root < V; root++){
+            if(seen[root]) continue;
+
+            // collect the component with a search from its first node.. which also seeds the bounds.
+            // Directed, that's what root reaches and what reaches root back
+            search(root);
+            std::vector<int> component;
+            for(auto w : forwardVisited) if(backward(w) != -1) component.push_back(w);
+            for(auto v : component) seen[v] = 1;
+
+            bool highSearch = true;
+            std::vector<int> candidates = component;
+            int v = root;
+
+            while(true){
+                Distance eccentricity = 0;
+                for(auto w : forwardVisited) eccentricity = std::max(eccentricity, forwardDistance[w]);
+
+                lower[v] = upper[v] = eccentricity;
+                for(auto w : component){
+                    lower[w] = std::max(lower[w], std::max(eccentricity - forwardDistance[w], backward(w)));
+                    upper[w] = std::min(upper[w], eccentricity + backward(w));
+                }
+                for(auto w : forwardVisited) forwardDistance[w] = -1; // reset for the next search
+                for(auto w : backwardVisited) backwardDistance[w] = -1;
+                backwardVisited.clear();
+
+                for(auto w : component){
+                    diameterLower = std::max(diameterLower, lower[w]);
+                    radiusUpper = std::min(radiusUpper, upper[w]);
+                }
+
+                std::vector<int> remainingCandidates;
+                for(auto w : candidates){
+                    if(lower[w] == upper[w]) continue;
+                    bool needed = forAll;
+                    if(forDiameter && upper[w] > diameterLower) needed = true;
+                    if(forRadius && lower[w] < radiusUpper) needed = true;
+                    if(needed) remainingCandidates.push_back(w);
+                }
+                candidates = remainingCandidates;
+
+                if(candidates.empty() || numSearches >= maxSearches) break;
+
+                if(v == root){ // second search of this component, start at the hub
+                    v = candidates[0];
+                    for(auto w : candidates) if(forwardGraph.outDegree(w) > forwardGraph.outDegree(v)) v = w;
+                }
+                else{
+                    v = candidates[0];
+                    for(auto w : candidates){
+                        if(highSearch && (upper[w] > upper[v] || (upper[w] == upper[v] && lower[w] > lower[v]))) v = w;
+                        if(!highSearch && (lower[w] < lower[v] || (lower[w] == lower[v] && upper[w] < upper[v]))) v = w;
+                    }
+                    highSearch = !highSearch;
+                }
+
+                search(v);
+            }
+
+            if(numSearches >= maxSearches) break;
+        }
+        return numSearches;
+    }
+
+    template <class T, class W>
+    void Eccentricity<T, W>::singleSourceDistances(CompressedGraph<T, W>& graph, int source, std::vector<Distance>& distance, std::vector<int>& visitedNodes){
+        visitedNodes.clear();
+        distance[source] = 0;
+        visitedNodes.push_back(source);
+
+        if(!graph.isWeighted()){
+            for(size_t head = 0; head < visitedNodes.size(); head++){ // visitedNodes is the BFS queue too
+                int v = visitedNodes[head];
+                for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                    int w = graph.targets[e];
+                    if(distance[w] != -1) continue;
+                    distance[w] = distance[v] + 1;
+                    visitedNodes.push_back(w);
+                }
+            }
+            return;
+        }
+
+        std::priority_queue<std::pair<Distance, int>, std::vector<std::pair<Distance, int>>, std::greater<std::pair<Distance, int>>> nodesToVisit;
+        nodesToVisit.push({0, source});
+        while(!nodesToVisit.empty()){
+            auto [currentDistance, v] = nodesToVisit.top();
+            nodesToVisit.pop();
+            if(currentDistance != distance[v]) continue; // stale entry..
+
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                int w = graph.targets[e];
+                Distance newDistance = distance[v] + graph.weights[e];
+                if(distance[w] != -1 && distance[w] <= newDistance) continue;
+                if(distance[w] == -1) visitedNodes.push_back(w);
+                distance[w] = newDistance;
+                nodesToVisit.push({newDistance, w});
+            }
+        }
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, typename WeightTraits<W>::Distance> Eccentricity<T, W>::diameterBounds(CompressedGraph<T, W>& graph, int maxSearches, bool directed){
+        std::vector<Distance> lower, upper;
+        boundEccentricities(graph, true, false, false, maxSearches, lower, upper, directed);
+        if(lower.empty()) return {0, 0};
+        return {*std::max_element(lower.begin(), lower.end()), *std::max_element(upper.begin(), upper.end())};
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Eccentricity<T, W>::exactRadius(CompressedGraph<T, W>& graph, bool directed){
+        std::vector<Distance> lower, upper;
+        boundEccentricities(graph, false, true, false, INT_MAX, lower, upper, directed);
+        if(upper.empty()) return 0;
+        return *std::min_element(upper.begin(), upper.end());
+    }
+
+    template <class T, class W>
+    std::tuple<std::map<Node<T>*, typename WeightTraits<W>::Distance>, std::map<Node<T>*, typename WeightTraits<W>::Distance>> Eccentricity<T, W>::nodeBounds(CompressedGraph<T, W>& graph, int maxSearches, bool directed){
+        std::vector<Distance> lower, upper;
+        boundEccentricities(graph, false, false, true, maxSearches, lower, upper, directed);
+
+        std::map<Node<T>*, Distance> nodeLower, nodeUpper;
+        for(int i = 0; i < graph.size(); i++){
+            nodeLower[graph.nodes[i]] = lower[i];
+            nodeUpper[graph.nodes[i]] = upper[i];
+        }
+        return {nodeLower, nodeUpper};
+    }
+}
+
+#endif // ECCENTRICITY_HPP
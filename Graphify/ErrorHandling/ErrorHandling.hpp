@@ -13,6 +13,8 @@
 #include <iostream>
 #include <string>
 #include <set>
+#include <vector>
+#include <algorithm>
 
 namespace Graphify{
 
@@ -27,7 +29,13 @@ namespace Graphify{
         EDGE_LIST_OUT_OF_BOUNDS_ERROR_NUM,
         WEIGHTED_EDGE_LIST_OUT_OF_BOUNDS_ERROR_NUM,
         WEIGHTED_ADJACENCY_MATRIX_OUT_OF_BOUNDS_ERROR_NUM,
-        FLOW_GRAPH_OUT_OF_BOUNDS_ERROR_NUM
+        FLOW_GRAPH_OUT_OF_BOUNDS_ERROR_NUM,
+        UNKNOWN_SHORTEST_PATH_QUEUE_METHOD_ERROR_NUM,
+        NEGATIVE_EDGE_WEIGHT_ERROR_NUM,
+        UNKNOWN_KRUSKAL_METHOD_ERROR_NUM,
+        UNKNOWN_LANDMARK_SELECTION_METHOD_ERROR_NUM,
+        TOO_MANY_NODES_FOR_EXACT_TOUR_ERROR_NUM,
+        NEGATIVE_CYCLE_ERROR_NUM
     };
 
     template <class T>
@@ -42,11 +50,17 @@ namespace Graphify{
             void checkOOBUnweightedAdjList(Graph<T> graph, Node<T>* node);
             void checkUnknwonUnweightedTraversal(std::string traversalMethod);
             void checkGraphAsDAG(Graph<T> graph);
-            void checkOOBWeightedAdjList(WeightedGraph<T> graph, Node<T>* node);
+            template <class W> void checkOOBWeightedAdjList(WeightedGraph<T, W>& graph, Node<T>* node);
             void checkOOBEdgeList(EdgeList<T> edgeList, int i);
-            void checkOOBWeightedEdgeList(WeightedEdgeList<T> edgeList, int i);
-            void checkOOBWeightedAdjacencyMatrix(WeightedAdjacencyMatrix<T> adjMat, int i);
-            void checkOOBFlowGraph(FlowGraph<T> graph, Node<T>* node);
+            template <class W> void checkOOBWeightedEdgeList(WeightedEdgeList<T, W>& edgeList, int i);
+            template <class W> void checkOOBWeightedAdjacencyMatrix(WeightedAdjacencyMatrix<T, W>& adjMat, int i);
+            template <class W> void checkOOBFlowGraph(FlowGraph<T, W>& graph, Node<T>* node);
+            void checkUnknownShortestPathQueueMethod(std::string queueMethod, std::vector<std::string> validMethods);
+            template <class W> void checkNonNegativeEdgeWeight(W weight); // for algorithms that only work without negative weights
+            void checkUnknownKruskalMethod(std::string kruskalMethod, std::vector<std::string> validMethods);
+            void checkUnknownLandmarkSelectionMethod(std::string selectionMethod, std::vector<std::string> validMethods);
+            void checkExactTourSize(int numNodes, int maxNodes);
+            void checkNoNegativeCycle(bool negativeCycle); // for all pairs shortest paths, which have no answer then
             
 
         private:
@@ -60,6 +74,12 @@ namespace Graphify{
             const std::string WEIGHTED_EDGE_LIST_OUT_OF_BOUNDS_ERROR;
             const std::string WEIGHTED_ADJACENCY_MATRIX_OUT_OF_BOUNDS_ERROR;
             const std::string FLOW_GRAPH_OUT_OF_BOUNDS_ERROR;
+            const std::string UNKNOWN_SHORTEST_PATH_QUEUE_METHOD_ERROR;
+            const std::string NEGATIVE_EDGE_WEIGHT_ERROR;
+            const std::string UNKNOWN_KRUSKAL_METHOD_ERROR;
+            const std::string UNKNOWN_LANDMARK_SELECTION_METHOD_ERROR;
+            const std::string TOO_MANY_NODES_FOR_EXACT_TOUR_ERROR;
+            const std::string NEGATIVE_CYCLE_ERROR;
     };
 
     template <class T>
@@ -73,7 +93,19 @@ namespace Graphify{
         EDGE_LIST_OUT_OF_BOUNDS_ERROR("Edge list index out of bounds!"),
         WEIGHTED_EDGE_LIST_OUT_OF_BOUNDS_ERROR("Weighted edge list index out of bounds!"),
         WEIGHTED_ADJACENCY_MATRIX_OUT_OF_BOUNDS_ERROR("Weighted adjacency matrix index out of bounds!"),
-        FLOW_GRAPH_OUT_OF_BOUNDS_ERROR("Flow graph index out of bounds!")
+        FLOW_GRAPH_OUT_OF_BOUNDS_ERROR("Flow graph index out of bounds!"),
+        UNKNOWN_SHORTEST_PATH_QUEUE_METHOD_ERROR("Unknown shortest path queue method!"
+        " Try running Graphify::WeightedTraversals::validQueueMethods() to find a list of valid methods."),
+        NEGATIVE_EDGE_WEIGHT_ERROR("Expected non-negative edge weights!"
+        " Try Graphify::WeightedTraversals::bellmanFordShortestPathTree() for graphs with negative weights."),
+        UNKNOWN_KRUSKAL_METHOD_ERROR("Unknown Kruskal method!"
+        " Try running Graphify::WeightedTraversals::validKruskalMethods() to find a list of valid methods."),
+        UNKNOWN_LANDMARK_SELECTION_METHOD_ERROR("Unknown landmark selection method!"
+        " Try running Graphify::Landmarks::validSelectionMethods() to find a list of valid methods."),
+        TOO_MANY_NODES_FOR_EXACT_TOUR_ERROR("Too many nodes for an exact travelling salesman tour!"
+        " Returning Graphify::WeightedTraversals::approximateTravellingSalesmanTour()'s tour instead, which may not be the shortest."),
+        NEGATIVE_CYCLE_ERROR("Negative cycle found, there are no shortest paths!"
+        " Try Graphify::WeightedTraversals::bellmanFordShortestPathTree() to see which nodes it affects.")
     {}
 
     template <class T>
@@ -122,7 +154,8 @@ namespace Graphify{
     }
 
     template <class T>
-    void ErrorHandling<T>::checkOOBWeightedAdjList(WeightedGraph<T> graph, Node<T>* node){
+    template <class W>
+    void ErrorHandling<T>::checkOOBWeightedAdjList(WeightedGraph<T, W>& graph, Node<T>* node){
         try{
             if(graph.find(node) == graph.end()){
                 GraphifyError e = WEIGHTED_GRAPH_OUT_OF_BOUNDS_ERROR_NUM;
@@ -146,7 +179,8 @@ namespace Graphify{
     }
 
     template <class T>
-    void ErrorHandling<T>::checkOOBWeightedEdgeList(WeightedEdgeList<T> edgeList, int i){
+    template <class W>
+    void ErrorHandling<T>::checkOOBWeightedEdgeList(WeightedEdgeList<T, W>& edgeList, int i){
         try{
             if(i > edgeList.size()-1){
                 GraphifyError e = WEIGHTED_EDGE_LIST_OUT_OF_BOUNDS_ERROR_NUM;
@@ -158,7 +192,8 @@ namespace Graphify{
     }
 
     template <class T>
-    void ErrorHandling<T>::checkOOBWeightedAdjacencyMatrix(WeightedAdjacencyMatrix<T> adjMat, int i){
+    template <class W>
+    void ErrorHandling<T>::checkOOBWeightedAdjacencyMatrix(WeightedAdjacencyMatrix<T, W>& adjMat, int i){
         try{
             if(i > adjMat.size()-1){
                 GraphifyError e = WEIGHTED_ADJACENCY_MATRIX_OUT_OF_BOUNDS_ERROR_NUM;
@@ -170,7 +205,8 @@ namespace Graphify{
     }
 
     template <class T>
-    void ErrorHandling<T>::checkOOBFlowGraph(FlowGraph<T> graph, Node<T>* node){
+    template <class W>
+    void ErrorHandling<T>::checkOOBFlowGraph(FlowGraph<T, W>& graph, Node<T>* node){
         try{
             if(graph.find(node) == graph.end()){
                 GraphifyError e = FLOW_GRAPH_OUT_OF_BOUNDS_ERROR_NUM;
@@ -181,6 +217,79 @@ namespace Graphify{
         }  
     }
 
+    template <class T>
+    void ErrorHandling<T>::checkUnknownShortestPathQueueMethod(std::string queueMethod, std::vector<std::string> validMethods){
+        try{
+            if(std::find(validMethods.begin(), validMethods.end(), queueMethod) == validMethods.end()){
+                GraphifyError e = UNKNOWN_SHORTEST_PATH_QUEUE_METHOD_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << UNKNOWN_SHORTEST_PATH_QUEUE_METHOD_ERROR << "\n";
+        }
+    }
+
+    template <class T>
+    template <class W>
+    void ErrorHandling<T>::checkNonNegativeEdgeWeight(W weight){
+        try{
+            if(weight < 0){
+                GraphifyError e = NEGATIVE_EDGE_WEIGHT_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << NEGATIVE_EDGE_WEIGHT_ERROR << "\n";
+        }
+    }
+
+    template <class T>
+    void ErrorHandling<T>::checkUnknownKruskalMethod(std::string kruskalMethod, std::vector<std::string> validMethods){
+        try{
+            if(std::find(validMethods.begin(), validMethods.end(), kruskalMethod) == validMethods.end()){
+                GraphifyError e = UNKNOWN_KRUSKAL_METHOD_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << UNKNOWN_KRUSKAL_METHOD_ERROR << "\n";
+        }
+    }
+
+    template <class T>
+    void ErrorHandling<T>::checkUnknownLandmarkSelectionMethod(std::string selectionMethod, std::vector<std::string> validMethods){
+        try{
+            if(std::find(validMethods.begin(), validMethods.end(), selectionMethod) == validMethods.end()){
+                GraphifyError e = UNKNOWN_LANDMARK_SELECTION_METHOD_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << UNKNOWN_LANDMARK_SELECTION_METHOD_ERROR << "\n";
+        }
+    }
+
+    template <class T>
+    void ErrorHandling<T>::checkExactTourSize(int numNodes, int maxNodes){
+        try{
+            if(numNodes > maxNodes){
+                GraphifyError e = TOO_MANY_NODES_FOR_EXACT_TOUR_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << TOO_MANY_NODES_FOR_EXACT_TOUR_ERROR << "\n";
+        }
+    }
+
+    template <class T>
+    void ErrorHandling<T>::checkNoNegativeCycle(bool negativeCycle){
+        try{
+            if(negativeCycle){
+                GraphifyError e = NEGATIVE_CYCLE_ERROR_NUM;
+                throw e;
+            }
+        } catch(GraphifyError e){
+            std::cerr << errorDecorator(e) << NEGATIVE_CYCLE_ERROR << "\n";
+        }
+    }
+
     template <class T>
     std::string ErrorHandling<T>::errorDecorator(GraphifyError e){
         return "Graphify error number " + std::to_string(e) + ": ";
@@ -13,7 +13,7 @@
 namespace Graphify{
 
 
-    template <class T>
+    template <class T, class W>
     class WeightedEdgeList;
 
     // Min Component Size 
@@ -30,10 +30,11 @@ namespace Graphify{
     template <class T>
     class Graph;
 
-    template <class T>
+    // W is the capacity type, int unless asked otherwise
+    template <class T, class W = int>
     class FlowGraph{
         public:
-            std::vector<std::tuple<Node<T>*, int, int>> &operator[](Node<T>* node);
+            std::vector<std::tuple<Node<T>*, W, W>> &operator[](Node<T>* node);
 
             int outDegree(Node<T>* node);
             int maximumOutDegree();
@@ -41,22 +42,22 @@ namespace Graphify{
             int inDegree(Node<T>* node);
             int maximumInDegree();
 
-            void addNode(Node<T>* node, std::vector<std::tuple<Node<T>*, int, int>> nodeAdjList, std::string special="none");
-            void addEdge(Node<T>* node, std::tuple<Node<T>*, int, int> nodeAdjList);
+            void addNode(Node<T>* node, std::vector<std::tuple<Node<T>*, W, W>> nodeAdjList, std::string special="none");
+            void addEdge(Node<T>* node, std::tuple<Node<T>*, W, W> nodeAdjList);
 
-            void setMaxCapacity(Node<T>* node, Node<T>* baseNode, int newMaxCapacity);
-            int getMaxCapacity(Node <T>* node, Node<T>* baseNode);
+            void setMaxCapacity(Node<T>* node, Node<T>* baseNode, W newMaxCapacity);
+            W getMaxCapacity(Node <T>* node, Node<T>* baseNode);
 
-            void setCurrentCapacity(Node<T>* node, Node<T>* baseNode, int newCurrentCapacity);
-            int getCurrentCapacity(Node <T>* node, Node<T>* baseNode);
+            void setCurrentCapacity(Node<T>* node, Node<T>* baseNode, W newCurrentCapacity);
+            W getCurrentCapacity(Node <T>* node, Node<T>* baseNode);
 
             // void transpose();
 
-            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator find(Node<T>* node);
-            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator begin();
-            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator end();
-            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator rbegin();
-            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator rend();
+            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator find(Node<T>* node);
+            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator begin();
+            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator end();
+            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator rbegin();
+            typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator rend();
 
             size_t size();
             void erase(Node<T>* node);
@@ -71,27 +72,27 @@ namespace Graphify{
             Node<T>* sink; 
 
         private:
-            std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>> FlowGraph;
+            std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>> FlowGraph;
 
 
     };
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, int, int>>& FlowGraph<T>::operator[](Node<T>* node){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, W, W>>& FlowGraph<T, W>::operator[](Node<T>* node){
         ErrorHandling<T> handler;
-        handler.checkOOBFlowGraph(*this, node); // Pass current VALUE of instance of class to err handler..
+        handler.checkOOBFlowGraph(*this, node); // Pass the current instance of class to err handler (by reference, not a copy of the whole graph)..
         return FlowGraph[node];
 
     }
 
-    template <class T>
-    int FlowGraph<T>::outDegree(Node<T>* node){
+    template <class T, class W>
+    int FlowGraph<T, W>::outDegree(Node<T>* node){
         // vector.size() returns a size_t.. the cast is to be explicit about what we are returning
         return int(FlowGraph[node].size()); 
     }
     
-    template <class T>
-    int FlowGraph<T>::maximumOutDegree(){ 
+    template <class T, class W>
+    int FlowGraph<T, W>::maximumOutDegree(){ 
         int maxOutDegree = 0;
         for(auto [start, nodeAdjList] : FlowGraph){
             maxOutDegree = std::max(maxOutDegree, int(nodeAdjList.size()));
@@ -99,8 +100,8 @@ namespace Graphify{
         return maxOutDegree;
     }
 
-    template <class T>
-    int FlowGraph<T>::inDegree(Node<T>* node){
+    template <class T, class W>
+    int FlowGraph<T, W>::inDegree(Node<T>* node){
         int nodeInDegree = 0; 
         for(auto [start, nodeAdjList] : FlowGraph){
             bool found = false; 
@@ -114,27 +115,27 @@ namespace Graphify{
         return nodeInDegree;
     }
 
-    template <class T>
-    int FlowGraph<T>::maximumInDegree(){
+    template <class T, class W>
+    int FlowGraph<T, W>::maximumInDegree(){
         int maxInDegree = 0;
         for(auto [start, nodeAdjList] : FlowGraph) maxInDegree = std::max(maxInDegree, inDegree(start));
         return maxInDegree;
     }
 
-    template <class T>
-    void FlowGraph<T>::addNode(Node<T>* node, std::vector<std::tuple<Node<T>*, int, int>> nodeAdjList, std::string special){
+    template <class T, class W>
+    void FlowGraph<T, W>::addNode(Node<T>* node, std::vector<std::tuple<Node<T>*, W, W>> nodeAdjList, std::string special){
         if(special == "src") src = node; 
         if(special == "sink") sink = node; 
         FlowGraph.insert(std::make_pair(node, nodeAdjList));
     }
 
-    template <class T>
-    void FlowGraph<T>::addEdge(Node<T>* node, std::tuple<Node<T>*, int, int> nodeAdjList){
+    template <class T, class W>
+    void FlowGraph<T, W>::addEdge(Node<T>* node, std::tuple<Node<T>*, W, W> nodeAdjList){
         FlowGraph[node].push_back(nodeAdjList);
     }
 
-    template <class T>
-    int FlowGraph<T>::getMaxCapacity(Node <T>* node, Node<T>* baseNode){
+    template <class T, class W>
+    W FlowGraph<T, W>::getMaxCapacity(Node <T>* node, Node<T>* baseNode){
         for(auto [iterateNode, currentCapacity, maxCapacity] : FlowGraph[node]){
             if(iterateNode == baseNode){
                 return maxCapacity;
@@ -143,8 +144,8 @@ namespace Graphify{
         // throw not found error!
     }
 
-    template <class T>
-    void FlowGraph<T>::setMaxCapacity(Node <T>* node, Node<T>* baseNode, int newMaxCapacity){
+    template <class T, class W>
+    void FlowGraph<T, W>::setMaxCapacity(Node <T>* node, Node<T>* baseNode, W newMaxCapacity){
         for(auto it = FlowGraph[node].begin(); it != FlowGraph[node].end(); it++){
             if(std::get<0>(*it) == baseNode){
                 std::get<2>(*it) = newMaxCapacity;
@@ -153,8 +154,8 @@ namespace Graphify{
         }
     }
 
-    template <class T>
-    int FlowGraph<T>::getCurrentCapacity(Node <T>* node, Node<T>* baseNode){
+    template <class T, class W>
+    W FlowGraph<T, W>::getCurrentCapacity(Node <T>* node, Node<T>* baseNode){
         for(auto [iterateNode, currentCapacity, maxCapacity] : FlowGraph[node]){
             if(iterateNode == baseNode){
                 return currentCapacity;
@@ -163,8 +164,8 @@ namespace Graphify{
         // throw not found error!
     }
 
-    template <class T>
-    void FlowGraph<T>::setCurrentCapacity(Node <T>* node, Node<T>* baseNode, int newCurrentCapacity){
+    template <class T, class W>
+    void FlowGraph<T, W>::setCurrentCapacity(Node <T>* node, Node<T>* baseNode, W newCurrentCapacity){
         for(auto it = FlowGraph[node].begin(); it != FlowGraph[node].end(); it++){
             if(std::get<0>(*it) == baseNode){
                 std::get<1>(*it) = newCurrentCapacity;
@@ -174,8 +175,8 @@ namespace Graphify{
     }
 
     // template <class T>
-    // void FlowGraph<T>::transpose(){
-    //     std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>> transposedFlowGraph;
+    // void FlowGraph<T, W>::transpose(){
+    //     std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>> transposedFlowGraph;
         
     //     for(auto [node, nodeAdjList] : FlowGraph){
     //         for(auto [baseNode, weight] : nodeAdjList){
@@ -188,38 +189,38 @@ namespace Graphify{
     //     FlowGraph = transposedFlowGraph;
     // }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator FlowGraph<T>::find(Node<T>* node){
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator FlowGraph<T, W>::find(Node<T>* node){
         return FlowGraph.find(node);
     }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator FlowGraph<T>::begin(){
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator FlowGraph<T, W>::begin(){
         return FlowGraph.begin();
     }  
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator FlowGraph<T>::end(){
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator FlowGraph<T, W>::end(){
         return FlowGraph.end();
     }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator FlowGraph<T>::rbegin(){
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator FlowGraph<T, W>::rbegin(){
         return FlowGraph.rbegin();
     }  
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, int, int>>>::iterator FlowGraph<T>::rend(){
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::tuple<Node<T>*, W, W>>>::iterator FlowGraph<T, W>::rend(){
         return FlowGraph.rend();
     }
 
-    template <class T>
-    size_t FlowGraph<T>::size(){
+    template <class T, class W>
+    size_t FlowGraph<T, W>::size(){
         return FlowGraph.size();
     }
 
-    template <class T>
-    void FlowGraph<T>::erase(Node<T>* node){
+    template <class T, class W>
+    void FlowGraph<T, W>::erase(Node<T>* node){
         ErrorHandling<T> handler;
         handler.checkOOBFlowGraph(*this, node);
 
@@ -235,8 +236,8 @@ namespace Graphify{
         }
     }
 
-    template <class T>
-    void FlowGraph<T>::addBackwardEdges(){
+    template <class T, class W>
+    void FlowGraph<T, W>::addBackwardEdges(){
         for(auto [node, nodeAdjList] : FlowGraph){
             for(auto [baseNode, currentCapacity, maxCapacity] : nodeAdjList){
                 addEdge(baseNode, {node, 0, 0}); // adding each backward edge
@@ -245,8 +246,8 @@ namespace Graphify{
     }
     
 
-    template <class T>
-    std::vector<Node<T>*> FlowGraph<T>::getAllNodes(){
+    template <class T, class W>
+    std::vector<Node<T>*> FlowGraph<T, W>::getAllNodes(){
         std::vector<Node<T>*> nodes; 
         for(auto [node, nodeAdjList] : FlowGraph){
             nodes.push_back(node);
@@ -254,8 +255,8 @@ namespace Graphify{
         return nodes; 
     }
 
-    template <class T>
-    bool FlowGraph<T>::isFull(){
+    template <class T, class W>
+    bool FlowGraph<T, W>::isFull(){
         bool isSrcFull = true; 
 
         for(auto [node, currentCapacity, maxCapacity] : FlowGraph[src]){
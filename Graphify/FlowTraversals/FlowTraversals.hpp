@@ -2,12 +2,16 @@
 #define FLOWTRAVERSALS_HPP
 
 #include "FlowGraph/FlowGraph.hpp"
+#include "WeightTraits/WeightTraits.hpp"
 #include <map>
 #include <set>
 #include <tuple>
 
 #include <vector>
 #include <string>
+#include <climits>
+#include <limits>
+#include <type_traits>
 
 namespace Graphify{
 
@@ -17,22 +21,27 @@ namespace Graphify{
     template <class T>
     class EdgeList;
 
-    template <class T>
+    // W is the capacity type, like FlowGraph's. The total flow is summed in its Distance type, so many int capacities can't overflow it.
+    template <class T, class W = int>
     class FlowTraversals{
+        static_assert(std::is_signed<W>::value, "the backward edges carry negative flow, so capacities need a signed type");
+
         public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
             std::vector<std::string> validTraversalMethods(); // => ['DFS', 'BFS']
 
-            int fordFulkersonMaximumFlow(FlowGraph<T> graph, bool edmondsKarp=false);
-            int dinicMaximumFlow(FlowGraph<T> graph);
+            Distance fordFulkersonMaximumFlow(FlowGraph<T, W> graph, bool edmondsKarp=false);
+            Distance dinicMaximumFlow(FlowGraph<T, W> graph);
 
         private:
-            void fordFulkersonRecurse(FlowGraph<T>& graph, Node<T>* currentNode, std::set<Node<T>*>& visited, std::vector<Node<T>*>& nodesToBacktrack, int& currentIndex, int& finalMaxFlow);
+            void fordFulkersonRecurse(FlowGraph<T, W>& graph, Node<T>* currentNode, std::set<Node<T>*>& visited, std::vector<Node<T>*>& nodesToBacktrack, int& currentIndex, Distance& finalMaxFlow);
 
         
     };
 
-    template <class T>
-    std::vector<std::string> FlowTraversals<T>::validTraversalMethods(){
+    template <class T, class W>
+    std::vector<std::string> FlowTraversals<T, W>::validTraversalMethods(){
         return {"DFS", "BFS"}; 
     }
 
@@ -75,7 +84,7 @@ namespace Graphify{
 
     //         visited.insert(currentNode);
 
-    //         if(previousNode != nullptr) minFlow = std::min(minFlow, graph.getMaxCapacity(previousNode, currentNode) - graph.getCurrentCapacity(previousNode, currentNode));
+    //         if(previousNode != nullptr) minFlow = std::min<W>(minFlow, graph.getMaxCapacity(previousNode, currentNode) - graph.getCurrentCapacity(previousNode, currentNode));
 
     //         std::cout << currentNode->data << "\n";
 
@@ -117,8 +126,8 @@ namespace Graphify{
     //     return finalMaxFlow;
     // }
 
-    template <class T>
-    int FlowTraversals<T>::fordFulkersonMaximumFlow(FlowGraph<T> graph, bool edmondsKarp){
+    template <class T, class W>
+    typename WeightTraits<W>::Distance FlowTraversals<T, W>::fordFulkersonMaximumFlow(FlowGraph<T, W> graph, bool edmondsKarp){
         std::vector<Node<T>*> nodesToBacktrack;
         nodesToBacktrack.resize(graph.size());
 
@@ -127,7 +136,7 @@ namespace Graphify{
 
 
         std::set<Node<T>*> visited;
-        int finalMaxFlow = 0;  // we're returning this..
+        Distance finalMaxFlow = 0;  // we're returning this..
 
         bool pathFound = false; 
         do{
@@ -167,10 +176,10 @@ namespace Graphify{
             }
 
             if(pathFound){
-                int minFlow = INT_MAX;
+                W minFlow = std::numeric_limits<W>::max();
                 Node<T>* currentNode = graph.sink;
                 while(previousNode[currentNode] != nullptr){
-                    minFlow = std::min(minFlow, graph.getMaxCapacity(previousNode[currentNode], currentNode) - graph.getCurrentCapacity(previousNode[currentNode], currentNode));
+                    minFlow = std::min<W>(minFlow, graph.getMaxCapacity(previousNode[currentNode], currentNode) - graph.getCurrentCapacity(previousNode[currentNode], currentNode));
                     currentNode = previousNode[currentNode];
                 }
 
@@ -195,8 +204,8 @@ namespace Graphify{
 
     }
 
-    template <class T>
-    void FlowTraversals<T>::fordFulkersonRecurse(FlowGraph<T>& graph, Node<T>* currentNode, std::set<Node<T>*>& visited, std::vector<Node<T>*>& nodesToBacktrack, int& currentIndex, int& finalMaxFlow){
+    template <class T, class W>
+    void FlowTraversals<T, W>::fordFulkersonRecurse(FlowGraph<T, W>& graph, Node<T>* currentNode, std::set<Node<T>*>& visited, std::vector<Node<T>*>& nodesToBacktrack, int& currentIndex, Distance& finalMaxFlow){
 
         if(visited.find(currentNode) != visited.end()) return;
 
@@ -212,9 +221,9 @@ namespace Graphify{
 
             bool stop = false; 
 
-            int minFlow = INT_MAX;
+            W minFlow = std::numeric_limits<W>::max();
             for(int i = pathCurrentIndex-1; i >= 1; i--){
-                minFlow = std::min(minFlow, graph.getMaxCapacity(path[i-1], path[i]) - graph.getCurrentCapacity(path[i-1], path[i]));
+                minFlow = std::min<W>(minFlow, graph.getMaxCapacity(path[i-1], path[i]) - graph.getCurrentCapacity(path[i-1], path[i]));
             }
             for(int i = pathCurrentIndex-1; i >= 1; i--){
                 // this should never result in a segfault.. if the graph size is at least 2, the two nodes are the src & sink.
@@ -249,14 +258,14 @@ namespace Graphify{
         visited.erase(currentNode);
     }
 
-    template <class T>
-    int FlowTraversals<T>::dinicMaximumFlow(FlowGraph<T> graph){
+    template <class T, class W>
+    typename WeightTraits<W>::Distance FlowTraversals<T, W>::dinicMaximumFlow(FlowGraph<T, W> graph){
         std::vector<Node<T>*> nodesToBacktrack;
         nodesToBacktrack.resize(graph.size());
 
         // don't forget to add backward edges to graph as per FF.
         graph.addBackwardEdges();
-        int finalMaxFlow = 0;  // we're returning this..
+        Distance finalMaxFlow = 0;  // we're returning this..
 
 
         bool pathFound = false; 
@@ -322,10 +331,10 @@ namespace Graphify{
             }
 
             if(pathFound){
-                int minFlow = INT_MAX;
+                W minFlow = std::numeric_limits<W>::max();
                 Node<T>* currentNode = graph.sink;
                 while(previousNode[currentNode] != nullptr){
-                    minFlow = std::min(minFlow, graph.getMaxCapacity(previousNode[currentNode], currentNode) - graph.getCurrentCapacity(previousNode[currentNode], currentNode));
+                    minFlow = std::min<W>(minFlow, graph.getMaxCapacity(previousNode[currentNode], currentNode) - graph.getCurrentCapacity(previousNode[currentNode], currentNode));
                     currentNode = previousNode[currentNode];
                 }
 
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "Node/Node.hpp"
 #include "EdgeList/EdgeList.hpp"
+#include "MutationEpoch/MutationEpoch.hpp"
 
 #include "ErrorHandling/ErrorHandling.hpp"
 
@@ -24,6 +25,12 @@ namespace Graphify{
     template <class T>
     class Graph{
         public:
+            Graph() = default;
+            Graph(const Graph<T>& other);
+            Graph(Graph<T>&& other);
+            Graph<T>& operator=(const Graph<T>& other);
+            Graph<T>& operator=(Graph<T>&& other);
+
             std::vector<Node<T>*> &operator[](Node<T>* node);
 
             int outDegree(Node<T>* node);
@@ -51,6 +58,10 @@ namespace Graphify{
             size_t size();
             void erase(Node<T>* node);
 
+            // changed by every mutating member and by copies/assignment (but not by writes through
+            // operator[]), so indexes and caches built from this graph can tell when they have gone stale
+            size_t mutationEpoch();
+
             bool eulerianCircutExists();
             bool eulerianPathExists();
 
@@ -59,10 +70,40 @@ namespace Graphify{
 
         private:
             std::map<Node<T>*, std::vector<Node<T>*>> graph;
+            size_t epoch = nextMutationEpoch();
 
 
     };
 
+    // the epoch is never copied, a copy is a new graph as far as any index is concerned
+    template <class T>
+    Graph<T>::Graph(const Graph<T>& other)
+    : graph(other.graph)
+    {
+    }
+
+    template <class T>
+    Graph<T>::Graph(Graph<T>&& other)
+    : graph(std::move(other.graph))
+    {
+        other.epoch = nextMutationEpoch();
+    }
+
+    template <class T>
+    Graph<T>& Graph<T>::operator=(const Graph<T>& other){
+        graph = other.graph;
+        epoch = nextMutationEpoch();
+        return *this;
+    }
+
+    template <class T>
+    Graph<T>& Graph<T>::operator=(Graph<T>&& other){
+        graph = std::move(other.graph);
+        epoch = nextMutationEpoch();
+        other.epoch = nextMutationEpoch();
+        return *this;
+    }
+
     template <class T>
     typename std::vector<Node<T>*>& Graph<T>::operator[](Node<T>* node){
         ErrorHandling<T> handler;
@@ -107,11 +148,13 @@ namespace Graphify{
     template <class T>
     void Graph<T>::addNode(Node<T>* node, std::vector<Node<T>*> adjNodeList){
         graph.insert(std::make_pair(node, adjNodeList));
+        epoch = nextMutationEpoch();
     }
 
     template <class T>
     void Graph<T>::addEdge(Node<T>* node, Node<T>* baseNode){
         graph[node].push_back(baseNode);
+        epoch = nextMutationEpoch();
     }
 
     template <class T>
@@ -139,6 +182,7 @@ namespace Graphify{
         }
 
         graph = completeGraph;
+        epoch = nextMutationEpoch();
 
     }
 
@@ -155,6 +199,7 @@ namespace Graphify{
             if(transposedGraph.find(node) == transposedGraph.end()) transposedGraph[node] = {};
         }
         graph = transposedGraph;
+        epoch = nextMutationEpoch();
     }
 
     template <class T>
@@ -198,6 +243,12 @@ namespace Graphify{
             nodeAdjList.erase(std::remove(nodeAdjList.begin(), nodeAdjList.end(), node), nodeAdjList.end());
             graph[start] = nodeAdjList;
         }
+        epoch = nextMutationEpoch();
+    }
+
+    template <class T>
+    size_t Graph<T>::mutationEpoch(){
+        return epoch;
     }
 
  template <class T>
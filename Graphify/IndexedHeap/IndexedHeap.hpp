@@ -0,0 +1,174 @@
+#ifndef INDEXEDHEAP_HPP
+#define INDEXEDHEAP_HPP
+
+#include <vector>
+#include <utility>
+
+namespace Graphify{
+
+    /*
+        A d-ary min heap over the dense ids 0 .. capacity-1 (CSR node indices), with the
+        position of every id tracked so a key can be decreased in place. Each id is in the
+        heap at most once, unlike the lazy "push duplicates and skip stale entries" approach.
+
+        A 4-ary heap is shallower than a binary one and its children share a cache line,
+        which is usually the best trade off for Dijkstra's many decreaseKeys and few pops.
+    */
+    template <class Key, int Arity=4>
+    class IndexedHeap{
+        public:
+            IndexedHeap(int capacity=0);
+
+            bool empty();
+            int size();
+            bool contains(int id);
+
+            void push(int id, Key key);
+            void decreaseKey(int id, Key key);
+            bool pushOrDecrease(int id, Key key); // => true if the id was pushed or its key lowered
+
+            int top();
+            Key topKey();
+            Key key(int id);
+            int pop();
+
+            void clear(); // O(size), not O(capacity)
+            void resize(int capacity);
+
+        private:
+            std::vector<std::pair<Key, int>> heap; // {key, id}
+            std::vector<int> position; // id => index in heap, -1 if absent
+
+            void siftUp(int i);
+            void siftDown(int i);
+    };
+
+    template <class Key, int Arity>
+    IndexedHeap<Key, Arity>::IndexedHeap(int capacity)
+    : position(capacity, -1)
+    { }
+
+    template <class Key, int Arity>
+    bool IndexedHeap<Key, Arity>::empty(){
+        return heap.empty();
+    }
+
+    template <class Key, int Arity>
+    int IndexedHeap<Key, Arity>::size(){
+        return int(heap.size());
+    }
+
+    template <class Key, int Arity>
+    bool IndexedHeap<Key, Arity>::contains(int id){
+        return position[id] != -1;
+    }
+
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::push(int id, Key key){
+        position[id] = int(heap.size());
+        heap.push_back({key, id});
+        siftUp(position[id]);
+    }
+
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::decreaseKey(int id, Key key){
+        heap[position[id]].first = key;
+        siftUp(position[id]);
+    }
+
+    template <class Key, int Arity>
+    bool IndexedHeap<Key, Arity>::pushOrDecrease(int id, Key key){
+        if(position[id] == -1){
+            push(id, key);
+            return true;
+        }
+        if(key < heap[position[id]].first){
+            decreaseKey(id, key);
+            return true;
+        }
+        return false;
+    }
+
+    template <class Key, int Arity>
+    int IndexedHeap<Key, Arity>::top(){
+        return heap[0].second;
+    }
+
+    template <class Key, int Arity>
+    Key IndexedHeap<Key, Arity>::topKey(){
+        return heap[0].first;
+    }
+
+    template <class Key, int Arity>
+    Key IndexedHeap<Key, Arity>::key(int id){
+        return heap[position[id]].first;
+    }
+
+    template <class Key, int Arity>
+    int IndexedHeap<Key, Arity>::pop(){
+        int id = heap[0].second;
+        position[id] = -1;
+
+        if(heap.size() > 1){
+            heap[0] = heap.back();
+            position[heap[0].second] = 0;
+            heap.pop_back();
+            siftDown(0);
+        }
+        else heap.pop_back();
+
+        return id;
+    }
+
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::clear(){
+        for(auto& entry : heap) position[entry.second] = -1;
+        heap.clear();
+    }
+
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::resize(int capacity){
+        clear();
+        position.assign(capacity, -1);
+    }
+
+    // moving a hole instead of swapping saves half the writes
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::siftUp(int i){
+        auto entry = heap[i];
+        while(i > 0){
+            int parent = (i - 1) / Arity;
+            if(!(entry.first < heap[parent].first)) break;
+            heap[i] = heap[parent];
+            position[heap[i].second] = i;
+            i = parent;
+        }
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+
+    template <class Key, int Arity>
+    void IndexedHeap<Key, Arity>::siftDown(int i){
+        auto entry = heap[i];
+        int n = int(heap.size());
+        while(true){
+            int firstChild = i * Arity + 1;
+            if(firstChild >= n) break;
+
+            int smallest = firstChild;
+            int lastChild = firstChild + Arity < n ? firstChild + Arity : n;
+            for(int child = firstChild + 1; child < lastChild; child++){
+                if(heap[child].first < heap[smallest].first) smallest = child;
+            }
+            if(!(heap[smallest].first < entry.first)) break;
+
+            heap[i] = heap[smallest];
+            position[heap[i].second] = i;
+            i = smallest;
+        }
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+}
+
+#endif // INDEXEDHEAP_HPP
@@ -0,0 +1,204 @@
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "WeightedTraversals/WeightedTraversals.hpp"
+#include "Parallel/Parallel.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include "ErrorHandling/ErrorHandling.hpp"
+#include <map>
+#include <vector>
+#include <string>
+#include <random>
+#include <climits>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        ALT (A*, landmarks, triangle inequality) preprocessing, Goldberg & Harrelson.
+
+        A few landmark nodes get their exact distances to and from every node. For any landmark L
+        the triangle inequality gives
+
+            d(v, t) >= d(L, t) - d(L, v)    and    d(v, t) >= d(v, L) - d(t, L)
+
+        and the largest of these over all landmarks is an admissible (and consistent) A* heuristic.
+        Distances are stored node major, so one heuristic call reads a single contiguous run of
+        numLandmarks Distances per direction. Weights must be non-negative.
+
+        The index works on CSR numbering, so query with a CompressedGraph built from the same graph:
+
+            Landmarks<T, W> landmarks(compressedGraph, 16);
+            traversals.alphaStarShortestPath(compressedGraph, start, end, landmarks.heuristicTo(end));
+    */
+    template <class T, class W = int>
+    class Landmarks{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            // selectionMethod: "farthest" (each landmark is the node farthest from the ones picked so far) or "random"
+            static std::vector<std::string> validSelectionMethods(); // => ['farthest', 'random']
+            Landmarks(CompressedGraph<T, W>& graph, int numLandmarks=8, std::string selectionMethod="farthest", int numThreads=0, unsigned int seed=0);
+            Landmarks(WeightedGraph<T, W>& graph, int numLandmarks=8, std::string selectionMethod="farthest", int numThreads=0, unsigned int seed=0);
+
+            // small copyable functor for alphaStarShortestPath, bound to one target
+            struct Heuristic{
+                Landmarks<T, W>* landmarks;
+                int target;
+                Distance operator()(int node){ return landmarks->lowerBound(node, target); }
+            };
+
+            Heuristic heuristicTo(Node<T>* end);
+            Heuristic heuristicTo(int target);
+
+            Distance lowerBound(int node, int target); // by CSR index, => 0 if the landmarks know nothing useful
+            Distance lowerBound(Node<T>* start, Node<T>* end);
+
+            int numLandmarks();
+            std::vector<Node<T>*> landmarkNodes();
+
+        private:
+            int landmarkCount;
+            std::vector<int> landmarkIndices;
+            std::vector<Distance> distanceFromLandmark; // [node * landmarkCount + l] = d(landmark l, node), WeightTraits<W>::unreachable() if unreachable
+            std::vector<Distance> distanceToLandmark; // [node * landmarkCount + l] = d(node, landmark l)
+
+            std::vector<Node<T>*> nodes;
+            std::map<Node<T>*, int> nodeToIndex;
+
+            void build(CompressedGraph<T, W>& graph, int numLandmarks, std::string selectionMethod, int numThreads, unsigned int seed);
+    };
+
+    template <class T, class W>
+    Landmarks<T, W>::Landmarks(CompressedGraph<T, W>& graph, int numLandmarks, std::string selectionMethod, int numThreads, unsigned int seed)
+    : landmarkCount(0)
+    {
+        build(graph, numLandmarks, selectionMethod, numThreads, seed);
+    }
+
+    template <class T, class W>
+    Landmarks<T, W>::Landmarks(WeightedGraph<T, W>& graph, int numLandmarks, std::string selectionMethod, int numThreads, unsigned int seed)
+    : landmarkCount(0)
+    {
+        CompressedGraph<T, W> compressedGraph(graph);
+        build(compressedGraph, numLandmarks, selectionMethod, numThreads, seed);
+    }
+
+    template <class T, class W>
+    std::vector<std::string> Landmarks<T, W>::validSelectionMethods(){
+        return {"farthest", "random"};
+    }
+
+    template <class T, class W>
+    typename Landmarks<T, W>::Heuristic Landmarks<T, W>::heuristicTo(Node<T>* end){
+        auto it = nodeToIndex.find(end);
+        return heuristicTo(it == nodeToIndex.end() ? -1 : it->second);
+    }
+
+    template <class T, class W>
+    typename Landmarks<T, W>::Heuristic Landmarks<T, W>::heuristicTo(int target){
+        return {this, target};
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Landmarks<T, W>::lowerBound(int node, int target){
+        if(node < 0 || target < 0) return 0;
+
+        const Distance* fromNode = distanceFromLandmark.data() + (size_t)node * landmarkCount;
+        const Distance* fromTarget = distanceFromLandmark.data() + (size_t)target * landmarkCount;
+        const Distance* toNode = distanceToLandmark.data() + (size_t)node * landmarkCount;
+        const Distance* toTarget = distanceToLandmark.data() + (size_t)target * landmarkCount;
+
+        const Distance UNREACHABLE = WeightTraits<W>::unreachable();
+        Distance bound = 0;
+        for(int l = 0; l < landmarkCount; l++){
+            // an unreachable side gives no bound.. skipping it keeps the heuristic admissible
+            if(fromNode[l] != UNREACHABLE && fromTarget[l] != UNREACHABLE) bound = std::max(bound, fromTarget[l] - fromNode[l]);
+            if(toNode[l] != UNREACHABLE && toTarget[l] != UNREACHABLE) bound = std::max(bound, toNode[l] - toTarget[l]);
+        }
+        return bound;
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance Landmarks<T, W>::lowerBound(Node<T>* start, Node<T>* end){
+        auto startIt = nodeToIndex.find(start);
+        auto endIt = nodeToIndex.find(end);
+        if(startIt == nodeToIndex.end() || endIt == nodeToIndex.end()) return 0;
+        return lowerBound(startIt->second, endIt->second);
+    }
+
+    template <class T, class W>
+    int Landmarks<T, W>::numLandmarks(){
+        return landmarkCount;
+    }
+
+    template <class T, class W>
+    std::vector<Node<T>*> Landmarks<T, W>::landmarkNodes(){
+        std::vector<Node<T>*> landmarks;
+        for(auto l : landmarkIndices) landmarks.push_back(nodes[l]);
+        return landmarks;
+    }
+
+    /*
+        Farthest selection is inherently one landmark at a time (the next pick depends on every
+        distance so far), so only the searches on the reverse graph run in parallel. An unreachable
+        node counts as infinitely far, so every component that needs one gets a landmark.
+    */
+    template <class T, class W>
+    void Landmarks<T, W>::build(CompressedGraph<T, W>& graph, int numLandmarks, std::string selectionMethod, int numThreads, unsigned int seed){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return build(weightedGraph, numLandmarks, selectionMethod, numThreads, seed); }
+        ErrorHandling<T> handler;
+        handler.checkUnknownLandmarkSelectionMethod(selectionMethod, validSelectionMethods()); // reported, then treated like "farthest"
+
+        nodes = graph.nodes;
+        nodeToIndex = graph.nodeToIndex;
+
+        const Distance UNREACHABLE = WeightTraits<W>::unreachable();
+        int V = graph.size();
+        landmarkCount = std::max(0, std::min(numLandmarks, V));
+        landmarkIndices.clear();
+        distanceFromLandmark.assign((size_t)V * landmarkCount, UNREACHABLE);
+        distanceToLandmark.assign((size_t)V * landmarkCount, UNREACHABLE);
+        if(landmarkCount == 0) return;
+
+        std::mt19937 rng(seed);
+        std::vector<Distance> distanceToNearestLandmark(V, UNREACHABLE);
+
+        if(selectionMethod == "random"){
+            std::vector<int> order(V);
+            for(int v = 0; v < V; v++) order[v] = v;
+            std::shuffle(order.begin(), order.end(), rng);
+            landmarkIndices.assign(order.begin(), order.begin() + landmarkCount);
+        }
+
+        WeightedTraversals<T, W> traversals;
+        int next = selectionMethod == "random" ? landmarkIndices[0] : int(rng() % V);
+        for(int l = 0; l < landmarkCount; l++){
+            if(selectionMethod != "random") landmarkIndices.push_back(next);
+
+            auto tree = traversals.djikstraShortestPathTree(graph, graph.nodes[landmarkIndices[l]]);
+            for(int v = 0; v < V; v++) distanceFromLandmark[(size_t)v * landmarkCount + l] = tree.nodeDistance[v];
+
+            if(selectionMethod == "random") continue;
+
+            for(int v = 0; v < V; v++) distanceToNearestLandmark[v] = std::min(distanceToNearestLandmark[v], tree.nodeDistance[v]);
+            for(auto landmark : landmarkIndices) distanceToNearestLandmark[landmark] = -1; // never pick the same one twice
+            next = int(std::max_element(distanceToNearestLandmark.begin(), distanceToNearestLandmark.end()) - distanceToNearestLandmark.begin());
+        }
+
+        auto reverseGraph = graph.transposed();
+        parallelFor(0, landmarkCount, [&](int l){
+            WeightedTraversals<T, W> reverseTraversals;
+            auto tree = reverseTraversals.djikstraShortestPathTree(reverseGraph, reverseGraph.nodes[landmarkIndices[l]]);
+            for(int v = 0; v < V; v++) distanceToLandmark[(size_t)v * landmarkCount + l] = tree.nodeDistance[v];
+        }, numThreads, 1);
+    }
+}
+
+#endif // LANDMARKS_HPP
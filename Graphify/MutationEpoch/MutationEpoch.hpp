@@ -0,0 +1,20 @@
+#ifndef MUTATIONEPOCH_HPP
+#define MUTATIONEPOCH_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace Graphify{
+
+    /*
+        Every graph state (of any Graph or WeightedGraph) gets its own epoch from this one counter,
+        so a graph that was assigned over can't end up with the epoch an index (QueryCache,
+        ReachabilityIndex..) recorded for the graph it used to be.
+    */
+    inline size_t nextMutationEpoch(){
+        static std::atomic<size_t> counter(0);
+        return ++counter;
+    }
+}
+
+#endif // MUTATIONEPOCH_HPP
@@ -0,0 +1,104 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <functional>
+#include <iterator>
+
+namespace Graphify{
+
+    // 0 (the default everywhere in the library) means "use every hardware thread".
+    inline int resolveNumThreads(int numThreads, int amountOfWork){
+        if(numThreads <= 0){
+            numThreads = int(std::thread::hardware_concurrency());
+            if(numThreads <= 0) numThreads = 1; // hardware_concurrency() is allowed to return 0..
+        }
+        return std::max(1, std::min(numThreads, amountOfWork));
+    }
+
+    /*
+        Runs func on every index in [begin, end) over numThreads threads.
+        Indices are handed out in chunks from a shared counter, so vertices with very
+        different amounts of work (hubs vs leaves) still balance out across threads.
+
+        func may either take (int i) or (int i, int threadId)- the latter is for
+        callers that keep thread-local accumulators indexed by threadId. threadId is always
+        below resolveNumThreads(numThreads, end - begin), so size the accumulators with that.
+    */
+    template <class Func>
+    void parallelFor(int begin, int end, Func func, int numThreads=0, int chunkSize=64){
+        if(end <= begin) return;
+
+        int amountOfWork = end - begin;
+        chunkSize = std::max(1, chunkSize);
+        numThreads = resolveNumThreads(numThreads, (amountOfWork + chunkSize - 1) / chunkSize);
+
+        std::atomic<int> nextIndex(begin);
+
+        auto worker = [&](int threadId){
+            while(true){
+                int chunkBegin = nextIndex.fetch_add(chunkSize);
+                if(chunkBegin >= end) return;
+                int chunkEnd = std::min(end, chunkBegin + chunkSize);
+                for(int i = chunkBegin; i < chunkEnd; i++){
+                    if constexpr(std::is_invocable_v<Func, int, int>) func(i, threadId);
+                    else func(i);
+                }
+            }
+        };
+
+        if(numThreads == 1){ // no point in spawning anything..
+            worker(0);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        for(int threadId = 1; threadId < numThreads; threadId++){
+            threads.emplace_back(worker, threadId);
+        }
+        worker(0); // the calling thread does its share too
+        for(auto& thread : threads) thread.join();
+    }
+
+    /*
+        std::sort over numThreads threads: each thread sorts one contiguous run, then neighbouring
+        runs are merged pairwise, with the merges of a round running in parallel too. Below
+        minRunSize elements per thread it isn't worth spawning anything and it's a plain std::sort.
+    */
+    template <class RandomIt, class Compare>
+    void parallelSort(RandomIt first, RandomIt last, Compare comp, int numThreads=0, int minRunSize=1 << 14){
+        int amountOfWork = int(last - first);
+        int numRuns = resolveNumThreads(numThreads, std::max(1, amountOfWork / std::max(1, minRunSize)));
+        if(numRuns == 1){
+            std::sort(first, last, comp);
+            return;
+        }
+
+        std::vector<RandomIt> bounds;
+        for(int run = 0; run <= numRuns; run++) bounds.push_back(first + (long long)amountOfWork * run / numRuns);
+
+        parallelFor(0, numRuns, [&](int run){
+            std::sort(bounds[run], bounds[run+1], comp);
+        }, numRuns, 1);
+
+        for(int width = 1; width < numRuns; width *= 2){
+            int numMerges = (numRuns + 2 * width - 1) / (2 * width);
+            parallelFor(0, numMerges, [&](int merge){
+                int left = merge * 2 * width;
+                int middle = std::min(left + width, numRuns), right = std::min(left + 2 * width, numRuns);
+                if(middle < right) std::inplace_merge(bounds[left], bounds[middle], bounds[right], comp);
+            }, numRuns, 1);
+        }
+    }
+
+    template <class RandomIt>
+    void parallelSort(RandomIt first, RandomIt last, int numThreads=0){
+        parallelSort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>(), numThreads);
+    }
+}
+
+#endif // PARALLEL_HPP
@@ -0,0 +1,207 @@
+#ifndef QUERYCACHE_HPP
+#define QUERYCACHE_HPP
+
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "Traversals/Traversals.hpp"
+#include "WeightedTraversals/WeightedTraversals.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+namespace Graphify{
+
+    template <class T>
+    class Graph;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        Remembers the answers to repeated queries on one graph, keeping the capacity most recently
+        used ones (LRU). Like ReachabilityIndex, the cache remembers the graph it belongs to and
+        throws everything away on the first query after the graph was mutated (see mutationEpoch()),
+        so it never serves a stale answer. A hit is a hash lookup plus a list splice.
+
+            QueryCache<int> cache(graph, 4096);
+            auto [length, path] = cache.djikstraShortestPath(a, b); // searched
+            auto [again, samePath] = cache.djikstraShortestPath(a, b); // cached
+            graph.setWeight(a, b, 7); // the next query starts from an empty cache
+
+        Misses on a weighted graph are answered from a CompressedGraph snapshot that's also only
+        rebuilt after a mutation, so they don't copy the graph either.
+    */
+    template <class T, class W = int>
+    class QueryCache{
+        public:
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            QueryCache(Graph<T>& graph, size_t capacity=1024);
+            QueryCache(WeightedGraph<T, W>& graph, size_t capacity=1024);
+
+            std::tuple<int, std::vector<Node<T>*>> shortestPath(Node<T>* start, Node<T>* end); // Traversals, edge weights ignored
+            std::tuple<Distance, std::vector<Node<T>*>> djikstraShortestPath(Node<T>* start, Node<T>* end, std::string queueMethod="auto"); // weighted graphs only, => {-1, {}} otherwise
+            int numConnectedComponents(std::string traversalMethod="DFS");
+
+            bool isStale();
+            void clear();
+
+            size_t size();
+            size_t capacity();
+            size_t hits();
+            size_t misses();
+
+        private:
+            // {algorithm (and its method), start, end}
+            typedef std::tuple<std::string, Node<T>*, Node<T>*> Query;
+            typedef std::tuple<Distance, std::vector<Node<T>*>> Answer; // path lengths, or a count
+
+            struct QueryHash{
+                size_t operator()(const Query& query) const {
+                    size_t h = std::hash<std::string>()(std::get<0>(query));
+                    h ^= std::hash<Node<T>*>()(std::get<1>(query)) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                    h ^= std::hash<Node<T>*>()(std::get<2>(query)) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                    return h;
+                }
+            };
+
+            Graph<T>* graph;
+            WeightedGraph<T, W>* weightedGraph;
+            size_t cachedEpoch;
+            size_t maxEntries;
+            size_t numHits;
+            size_t numMisses;
+
+            std::list<std::pair<Query, Answer>> entries; // most recently used first
+            std::unordered_map<Query, typename std::list<std::pair<Query, Answer>>::iterator, QueryHash> lookup;
+
+            CompressedGraph<T, W> compressedGraph;
+            bool compressedGraphBuilt;
+
+            size_t currentEpoch();
+            Answer* find(const Query& query); // nullptr on a miss, drops everything first if the graph changed
+            void insert(const Query& query, Answer answer);
+    };
+
+    template <class T, class W>
+    QueryCache<T, W>::QueryCache(Graph<T>& graph, size_t capacity)
+    : graph(&graph), weightedGraph(nullptr), cachedEpoch(graph.mutationEpoch()), maxEntries(capacity), numHits(0), numMisses(0), compressedGraphBuilt(false)
+    { }
+
+    template <class T, class W>
+    QueryCache<T, W>::QueryCache(WeightedGraph<T, W>& graph, size_t capacity)
+    : graph(nullptr), weightedGraph(&graph), cachedEpoch(graph.mutationEpoch()), maxEntries(capacity), numHits(0), numMisses(0), compressedGraphBuilt(false)
+    { }
+
+    template <class T, class W>
+    std::tuple<int, std::vector<Node<T>*>> QueryCache<T, W>::shortestPath(Node<T>* start, Node<T>* end){
+        Query query = {"shortestPath", start, end};
+        if(Answer* cached = find(query)) return {int(std::get<0>(*cached)), std::get<1>(*cached)};
+
+        Traversals<T> traversals;
+        auto [length, path] = graph != nullptr ? traversals.shortestPath(*graph, start, end) : traversals.shortestPath(weightedGraph->unweightedGraph(), start, end);
+        insert(query, {length, path});
+        return {length, path};
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> QueryCache<T, W>::djikstraShortestPath(Node<T>* start, Node<T>* end, std::string queueMethod){
+        if(weightedGraph == nullptr) return {-1, {}};
+
+        Query query = {"djikstraShortestPath:" + queueMethod, start, end};
+        if(Answer* cached = find(query)) return *cached;
+
+        if(!compressedGraphBuilt){
+            compressedGraph = CompressedGraph<T, W>(*weightedGraph);
+            compressedGraphBuilt = true;
+        }
+        WeightedTraversals<T, W> traversals;
+        Answer answer = traversals.djikstraShortestPath(compressedGraph, start, end, queueMethod);
+        insert(query, answer);
+        return answer;
+    }
+
+    template <class T, class W>
+    int QueryCache<T, W>::numConnectedComponents(std::string traversalMethod){
+        Query query = {"numConnectedComponents:" + traversalMethod, nullptr, nullptr};
+        if(Answer* cached = find(query)) return int(std::get<0>(*cached));
+
+        Traversals<T> traversals;
+        int count = graph != nullptr ? traversals.numConnectedComponents(*graph, traversalMethod) : traversals.numConnectedComponents(weightedGraph->unweightedGraph(), traversalMethod);
+        insert(query, {count, {}});
+        return count;
+    }
+
+    template <class T, class W>
+    bool QueryCache<T, W>::isStale(){
+        return currentEpoch() != cachedEpoch;
+    }
+
+    template <class T, class W>
+    void QueryCache<T, W>::clear(){
+        entries.clear();
+        lookup.clear();
+        compressedGraph = CompressedGraph<T, W>();
+        compressedGraphBuilt = false;
+        cachedEpoch = currentEpoch();
+    }
+
+    template <class T, class W>
+    size_t QueryCache<T, W>::size(){
+        return entries.size();
+    }
+
+    template <class T, class W>
+    size_t QueryCache<T, W>::capacity(){
+        return maxEntries;
+    }
+
+    template <class T, class W>
+    size_t QueryCache<T, W>::hits(){
+        return numHits;
+    }
+
+    template <class T, class W>
+    size_t QueryCache<T, W>::misses(){
+        return numMisses;
+    }
+
+    template <class T, class W>
+    size_t QueryCache<T, W>::currentEpoch(){
+        return graph != nullptr ? graph->mutationEpoch() : weightedGraph->mutationEpoch();
+    }
+
+    template <class T, class W>
+    typename QueryCache<T, W>::Answer* QueryCache<T, W>::find(const Query& query){
+        if(isStale()) clear();
+
+        auto it = lookup.find(query);
+        if(it == lookup.end()){
+            numMisses++;
+            return nullptr;
+        }
+        numHits++;
+        entries.splice(entries.begin(), entries, it->second); // now the most recently used
+        return &it->second->second;
+    }
+
+    template <class T, class W>
+    void QueryCache<T, W>::insert(const Query& query, Answer answer){
+        if(maxEntries == 0) return;
+
+        entries.push_front({query, answer});
+        lookup[query] = entries.begin();
+        if(entries.size() > maxEntries){
+            lookup.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+}
+
+#endif // QUERYCACHE_HPP
@@ -0,0 +1,73 @@
+#ifndef RADIXHEAP_HPP
+#define RADIXHEAP_HPP
+
+#include <vector>
+#include <utility>
+#include <climits>
+
+namespace Graphify{
+
+    /*
+        A monotone radix heap (Ahuja et al.) for non-negative integer keys.
+
+        Bucket i holds keys whose highest bit differing from the last popped key is bit i-1
+        (bucket 0 holds keys equal to it). Popping from an empty bucket 0 redistributes the first
+        non-empty bucket around its minimum, and since keys only ever move to lower buckets each
+        entry is moved at most 64 times. No comparisons between entries are needed at all, which
+        is why it beats comparison heaps on integer Dijkstra. Like BucketQueue the entries are lazy.
+    */
+    class RadixHeap{
+        public:
+            RadixHeap();
+
+            bool empty();
+            void push(long long key, int id); // key must not be below the last popped key
+            std::pair<long long, int> pop(); // {key, id} with the smallest key
+
+        private:
+            std::vector<std::pair<unsigned long long, int>> buckets[65];
+            unsigned long long lastKey;
+            size_t count;
+
+            static int bucketIndex(unsigned long long key, unsigned long long last);
+    };
+
+    inline RadixHeap::RadixHeap()
+    : lastKey(0), count(0)
+    { }
+
+    inline bool RadixHeap::empty(){
+        return count == 0;
+    }
+
+    inline void RadixHeap::push(long long key, int id){
+        buckets[bucketIndex(key, lastKey)].push_back({(unsigned long long)key, id});
+        count++;
+    }
+
+    inline std::pair<long long, int> RadixHeap::pop(){
+        if(buckets[0].empty()){
+            int i = 1;
+            while(buckets[i].empty()) i++;
+
+            unsigned long long minKey = ULLONG_MAX;
+            for(auto& entry : buckets[i]) if(entry.first < minKey) minKey = entry.first;
+
+            lastKey = minKey;
+            for(auto& entry : buckets[i]) buckets[bucketIndex(entry.first, lastKey)].push_back(entry);
+            buckets[i].clear();
+        }
+
+        auto entry = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return {(long long)entry.first, entry.second};
+    }
+
+    inline int RadixHeap::bucketIndex(unsigned long long key, unsigned long long last){
+        if(key == last) return 0;
+        return 64 - __builtin_clzll(key ^ last);
+    }
+}
+
+#endif // RADIXHEAP_HPP
@@ -0,0 +1,297 @@
+#ifndef REACHABILITYINDEX_HPP
+#define REACHABILITYINDEX_HPP
+
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T>
+    class Graph;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        Precomputed answers to "is there a path from a to b?".
+
+        Strongly connected components are collapsed first (nodes in the same component always
+        reach each other), then the condensed DAG gets a pruned 2-hop labeling: every component
+        keeps a short sorted list of hub components it reaches (out labels) and is reached by
+        (in labels), and a reaches b exactly when those lists share a hub. A topological order
+        check rejects most negative queries before the labels are even looked at.
+
+        Only the edges matter, W just has to match the weighted graph (or traversals) it's used with.
+
+        The index remembers the graph it was built from and rebuilds itself on the next query
+        after any mutation of that graph (see mutationEpoch()), so it never answers for a stale graph.
+    */
+    template <class T, class W = int>
+    class ReachabilityIndex{
+        public:
+            ReachabilityIndex(Graph<T>& graph);
+            ReachabilityIndex(WeightedGraph<T, W>& graph);
+
+            bool reachable(Node<T>* start, Node<T>* end);
+
+            bool isStale();
+            void rebuild();
+
+            int numComponents();
+            size_t labelSize(); // total number of label entries, a rough measure of the index's memory
+
+        private:
+            Graph<T>* graph;
+            WeightedGraph<T, W>* weightedGraph;
+            size_t builtEpoch;
+
+            std::unordered_map<Node<T>*, int> nodeToComponent;
+            std::vector<int> topologicalPosition; // component => position in a topological order of the DAG
+
+            std::vector<int> outLabelOffsets;
+            std::vector<int> outLabels;
+            std::vector<int> inLabelOffsets;
+            std::vector<int> inLabels;
+
+            void build(CompressedGraph<T, W>& compressedGraph);
+            std::vector<int> stronglyConnectedComponents(CompressedGraph<T, W>& compressedGraph, int& componentCount);
+            bool labelsIntersect(const int* a, int aSize, const int* b, int bSize);
+    };
+
+    template <class T, class W>
+    ReachabilityIndex<T, W>::ReachabilityIndex(Graph<T>& graph)
+    : graph(&graph), weightedGraph(nullptr), builtEpoch(0)
+    {
+        rebuild();
+    }
+
+    template <class T, class W>
+    ReachabilityIndex<T, W>::ReachabilityIndex(WeightedGraph<T, W>& graph)
+    : graph(nullptr), weightedGraph(&graph), builtEpoch(0)
+    {
+        rebuild();
+    }
+
+    template <class T, class W>
+    bool ReachabilityIndex<T, W>::reachable(Node<T>* start, Node<T>* end){
+        if(start == end) return true;
+        if(isStale()) rebuild();
+
+        auto startIt = nodeToComponent.find(start);
+        auto endIt = nodeToComponent.find(end);
+        if(startIt == nodeToComponent.end() || endIt == nodeToComponent.end()) return false;
+
+        int a = startIt->second;
+        int b = endIt->second;
+        if(a == b) return true;
+        if(topologicalPosition[a] > topologicalPosition[b]) return false; // b comes first, no edge can lead back to it
+
+        return labelsIntersect(outLabels.data() + outLabelOffsets[a], outLabelOffsets[a+1] - outLabelOffsets[a],
+                               inLabels.data() + inLabelOffsets[b], inLabelOffsets[b+1] - inLabelOffsets[b]);
+    }
+
+    template <class T, class W>
+    bool ReachabilityIndex<T, W>::isStale(){
+        if(graph != nullptr) return graph->mutationEpoch() != builtEpoch;
+        return weightedGraph->mutationEpoch() != builtEpoch;
+    }
+
+    template <class T, class W>
+    void ReachabilityIndex<T, W>::rebuild(){
+        if(graph != nullptr){
+            CompressedGraph<T, W> compressedGraph(*graph);
+            builtEpoch = graph->mutationEpoch();
+            build(compressedGraph);
+        }
+        else{
+            CompressedGraph<T, W> compressedGraph(*weightedGraph);
+            builtEpoch = weightedGraph->mutationEpoch();
+            build(compressedGraph);
+        }
+    }
+
+    template <class T, class W>
+    int ReachabilityIndex<T, W>::numComponents(){
+        return int(topologicalPosition.size());
+    }
+
+    template <class T, class W>
+    size_t ReachabilityIndex<T, W>::labelSize(){
+        return outLabels.size() + inLabels.size();
+    }
+
+    /*
+        Pruned labeling (Yano et al.): components are processed as hubs from the best connected
+        down. A hub's forward search stops at any component the labels so far already prove reachable
+        from the hub, and likewise for the backward search, which is what keeps the labels short.
+        Hubs are numbered by processing order so every label list comes out sorted.
+    */
+    template <class T, class W>
+    void ReachabilityIndex<T, W>::build(CompressedGraph<T, W>& compressedGraph){
+        int componentCount = 0;
+        auto component = stronglyConnectedComponents(compressedGraph, componentCount);
+
+        nodeToComponent.clear();
+        nodeToComponent.reserve(compressedGraph.size());
+        for(int i = 0; i < compressedGraph.size(); i++) nodeToComponent[compressedGraph.nodes[i]] = component[i];
+
+        // Tarjan numbers components sinks first, so reversing the ids gives a topological order
+        topologicalPosition.resize(componentCount);
+        for(int c = 0; c < componentCount; c++) topologicalPosition[c] = componentCount - 1 - c;
+
+        std::vector<std::vector<int>> successors(componentCount), predecessors(componentCount);
+        for(int i = 0; i < compressedGraph.size(); i++){
+            for(int e = compressedGraph.offsets[i]; e < compressedGraph.offsets[i+1]; e++){
+                int a = component[i], b = component[compressedGraph.targets[e]];
+                if(a != b) successors[a].push_back(b);
+            }
+        }
+        for(int c = 0; c < componentCount; c++){
+            std::sort(successors[c].begin(), successors[c].end());
+            successors[c].erase(std::unique(successors[c].begin(), successors[c].end()), successors[c].end());
+            for(auto d : successors[c]) predecessors[d].push_back(c);
+        }
+
+        std::vector<int> hubOrder(componentCount);
+        for(int c = 0; c < componentCount; c++) hubOrder[c] = c;
+        std::sort(hubOrder.begin(), hubOrder.end(), [&](int left, int right){
+            long long leftScore = (long long)(successors[left].size() + 1) * (predecessors[left].size() + 1);
+            long long rightScore = (long long)(successors[right].size() + 1) * (predecessors[right].size() + 1);
+            if(leftScore != rightScore) return leftScore > rightScore;
+            return left < right;
+        });
+
+        std::vector<std::vector<int>> outLabelLists(componentCount), inLabelLists(componentCount);
+        std::vector<char> visited(componentCount, 0);
+        std::vector<int> queue;
+
+        auto proven = [&](int a, int b){
+            auto& out = outLabelLists[a];
+            auto& in = inLabelLists[b];
+            return labelsIntersect(out.data(), int(out.size()), in.data(), int(in.size()));
+        };
+
+        for(int hub = 0; hub < componentCount; hub++){
+            int h = hubOrder[hub];
+
+            // forward: everything h reaches gets hub in its in label
+            queue.assign(1, h);
+            visited[h] = 1;
+            for(size_t head = 0; head < queue.size(); head++){
+                int c = queue[head];
+                if(proven(h, c)) continue;
+                inLabelLists[c].push_back(hub);
+                for(auto d : successors[c]){
+                    if(visited[d]) continue;
+                    visited[d] = 1;
+                    queue.push_back(d);
+                }
+            }
+            for(auto c : queue) visited[c] = 0;
+
+            // backward: everything that reaches h gets hub in its out label
+            queue.assign(1, h);
+            visited[h] = 1;
+            for(size_t head = 0; head < queue.size(); head++){
+                int c = queue[head];
+                if(c != h && proven(c, h)) continue;
+                outLabelLists[c].push_back(hub);
+                for(auto d : predecessors[c]){
+                    if(visited[d]) continue;
+                    visited[d] = 1;
+                    queue.push_back(d);
+                }
+            }
+            for(auto c : queue) visited[c] = 0;
+        }
+
+        auto flatten = [&](std::vector<std::vector<int>>& lists, std::vector<int>& labelOffsets, std::vector<int>& labels){
+            labelOffsets.assign(componentCount + 1, 0);
+            for(int c = 0; c < componentCount; c++) labelOffsets[c+1] = labelOffsets[c] + int(lists[c].size());
+            labels.clear();
+            labels.reserve(labelOffsets[componentCount]);
+            for(auto& list : lists) labels.insert(labels.end(), list.begin(), list.end());
+        };
+        flatten(outLabelLists, outLabelOffsets, outLabels);
+        flatten(inLabelLists, inLabelOffsets, inLabels);
+    }
+
+    // iterative Tarjan (no recursion, so long chains can't overflow the stack)
+    template <class T, class W>
+    std::vector<int> ReachabilityIndex<T, W>::stronglyConnectedComponents(CompressedGraph<T, W>& compressedGraph, int& componentCount){
+        int V = compressedGraph.size();
+        std::vector<int> component(V, -1);
+        std::vector<int> ids(V, -1);
+        std::vector<int> lowLinks(V, 0);
+        std::vector<int> nextEdge(V, 0);
+        std::vector<char> onStack(V, 0);
+        std::vector<int> componentStack;
+        std::vector<int> callStack;
+
+        int nextId = 0;
+        componentCount = 0;
+
+        for(int root = 0; root < V; root++){
+            if(ids[root] != -1) continue;
+
+            callStack.push_back(root);
+            while(!callStack.empty()){
+                int v = callStack.back();
+                if(ids[v] == -1){
+                    ids[v] = lowLinks[v] = nextId++;
+                    nextEdge[v] = compressedGraph.offsets[v];
+                    componentStack.push_back(v);
+                    onStack[v] = 1;
+                }
+
+                bool descended = false;
+                while(nextEdge[v] < compressedGraph.offsets[v+1]){
+                    int w = compressedGraph.targets[nextEdge[v]++];
+                    if(ids[w] == -1){
+                        callStack.push_back(w);
+                        descended = true;
+                        break;
+                    }
+                    if(onStack[w]) lowLinks[v] = std::min(lowLinks[v], ids[w]);
+                }
+                if(descended) continue;
+
+                callStack.pop_back();
+                if(!callStack.empty()){
+                    int parent = callStack.back();
+                    lowLinks[parent] = std::min(lowLinks[parent], lowLinks[v]);
+                }
+
+                if(lowLinks[v] == ids[v]){
+                    while(true){
+                        int w = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[w] = 0;
+                        component[w] = componentCount;
+                        if(w == v) break;
+                    }
+                    componentCount++;
+                }
+            }
+        }
+        return component;
+    }
+
+    template <class T, class W>
+    bool ReachabilityIndex<T, W>::labelsIntersect(const int* a, int aSize, const int* b, int bSize){
+        int i = 0, j = 0;
+        while(i < aSize && j < bSize){
+            if(a[i] == b[j]) return true;
+            if(a[i] < b[j]) i++;
+            else j++;
+        }
+        return false;
+    }
+}
+
+#endif // REACHABILITYINDEX_HPP
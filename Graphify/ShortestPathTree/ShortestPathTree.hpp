@@ -0,0 +1,144 @@
+#ifndef SHORTESTPATHTREE_HPP
+#define SHORTESTPATHTREE_HPP
+
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include <map>
+#include <vector>
+#include <climits>
+#include <limits>
+#include <algorithm>
+
+namespace Graphify{
+
+    template <class T>
+    class Node;
+
+    /*
+        The result of a one-to-all shortest path search: a distance and a parent for every node,
+        stored as two flat arrays by CSR index. That's all a shortest path tree needs, and any
+        individual path is walked out of the parent array only when it's asked for, so answering
+        many targets costs one search instead of one search per target.
+
+        D is the distance type, long long for integer weighted graphs and double for floating
+        point ones (WeightTraits<W>::Distance).
+    */
+    template <class T, class D = long long>
+    class ShortestPathTree{
+        public:
+            ShortestPathTree();
+            template <class W>
+            ShortestPathTree(CompressedGraph<T, W>& graph, int source); // nothing reached yet but the source
+
+            Node<T>* source();
+            int size();
+
+            bool isReachable(Node<T>* node);
+            D distanceTo(Node<T>* node); // => -1 if unreachable, like the per pair methods
+            Node<T>* parentOf(Node<T>* node); // => nullptr for the source and unreachable nodes
+            std::vector<Node<T>*> pathTo(Node<T>* node); // source .. node, {} if unreachable
+
+            std::vector<int> pathTo(int target); // same, but by CSR index
+            std::map<Node<T>*, D> distances(); // reachable nodes only
+
+            // by CSR index (same numbering as the CompressedGraph the tree was built from)
+            int sourceIndex;
+            std::vector<D> nodeDistance; // the largest D if unreachable
+            std::vector<int> previousNode; // -1 for the source and unreachable nodes
+            bool negativeCycle; // set by Bellman-Ford when a negative cycle is reachable, the distances are meaningless then
+
+            std::vector<Node<T>*> nodes;
+
+        private:
+            std::map<Node<T>*, int> nodeToIndex; // only built on the first lookup by node, copying it per search costs more than the search
+
+            int index(Node<T>* node);
+    };
+
+    template <class T, class D>
+    ShortestPathTree<T, D>::ShortestPathTree()
+    : sourceIndex(-1), negativeCycle(false)
+    { }
+
+    template <class T, class D>
+    template <class W>
+    ShortestPathTree<T, D>::ShortestPathTree(CompressedGraph<T, W>& graph, int source)
+    : sourceIndex(source), nodeDistance(graph.size(), std::numeric_limits<D>::max()), previousNode(graph.size(), -1), negativeCycle(false),
+      nodes(graph.nodes)
+    {
+        if(source >= 0 && source < graph.size()) nodeDistance[source] = 0;
+    }
+
+    template <class T, class D>
+    Node<T>* ShortestPathTree<T, D>::source(){
+        if(sourceIndex < 0 || sourceIndex >= size()) return nullptr;
+        return nodes[sourceIndex];
+    }
+
+    template <class T, class D>
+    int ShortestPathTree<T, D>::size(){
+        return int(nodes.size());
+    }
+
+    template <class T, class D>
+    bool ShortestPathTree<T, D>::isReachable(Node<T>* node){
+        int i = index(node);
+        return i != -1 && nodeDistance[i] != std::numeric_limits<D>::max();
+    }
+
+    template <class T, class D>
+    D ShortestPathTree<T, D>::distanceTo(Node<T>* node){
+        if(!isReachable(node)) return -1;
+        return nodeDistance[index(node)];
+    }
+
+    template <class T, class D>
+    Node<T>* ShortestPathTree<T, D>::parentOf(Node<T>* node){
+        int i = index(node);
+        if(i == -1 || previousNode[i] == -1) return nullptr;
+        return nodes[previousNode[i]];
+    }
+
+    template <class T, class D>
+    std::vector<Node<T>*> ShortestPathTree<T, D>::pathTo(Node<T>* node){
+        std::vector<Node<T>*> path;
+        int i = index(node);
+        if(i == -1) return path;
+
+        for(auto v : pathTo(i)) path.push_back(nodes[v]);
+        return path;
+    }
+
+    template <class T, class D>
+    std::vector<int> ShortestPathTree<T, D>::pathTo(int target){
+        std::vector<int> path;
+        if(target < 0 || target >= size() || nodeDistance[target] == std::numeric_limits<D>::max() || negativeCycle) return path; // parents can loop with a negative cycle..
+
+        for(int currentBackTrackedNode = target; currentBackTrackedNode != -1; currentBackTrackedNode = previousNode[currentBackTrackedNode]){
+            path.push_back(currentBackTrackedNode);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    template <class T, class D>
+    std::map<Node<T>*, D> ShortestPathTree<T, D>::distances(){
+        std::map<Node<T>*, D> reachableDistances;
+        for(int i = 0; i < size(); i++){
+            if(nodeDistance[i] != std::numeric_limits<D>::max()) reachableDistances[nodes[i]] = nodeDistance[i];
+        }
+        return reachableDistances;
+    }
+
+    template <class T, class D>
+    int ShortestPathTree<T, D>::index(Node<T>* node){
+        if(nodeToIndex.empty()){
+            for(int i = 0; i < size(); i++) nodeToIndex[nodes[i]] = i;
+        }
+        auto it = nodeToIndex.find(node);
+        if(it == nodeToIndex.end()) return -1;
+        return it->second;
+    }
+}
+
+#endif // SHORTESTPATHTREE_HPP
@@ -0,0 +1,103 @@
+#ifndef SPANNINGFOREST_HPP
+#define SPANNINGFOREST_HPP
+
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include <tuple>
+#include <vector>
+
+namespace Graphify{
+
+    template <class T>
+    class Node;
+
+    template <class T, class W>
+    class WeightedGraph;
+
+    /*
+        The result of a minimum spanning tree algorithm. Edge directions are ignored, so on a
+        disconnected graph this is a forest: one tree per (weakly) connected component, and
+        isolated nodes are trees of their own. Edges are kept as flat arrays by CSR index, and
+        which end is "from" means nothing. W is the weight type of the graph it spans.
+    */
+    template <class T, class W = int>
+    class SpanningForest{
+        public:
+            SpanningForest();
+            SpanningForest(CompressedGraph<T, W>& graph); // no edges yet, every node its own tree
+
+            void addEdge(int from, int to, W weight);
+
+            int size(); // nodes
+            int numEdges();
+            int numTrees(); // size() - numEdges(), a forest has one edge less than nodes per tree
+            typename WeightTraits<W>::Distance totalWeight();
+
+            std::vector<std::tuple<Node<T>*, Node<T>*, W>> edges();
+            WeightedGraph<T, W> weightedGraph(); // every node, including the isolated ones
+
+            // by CSR index (same numbering as the CompressedGraph the forest was built from)
+            std::vector<int> edgeFrom;
+            std::vector<int> edgeTo;
+            std::vector<W> edgeWeight;
+
+            std::vector<Node<T>*> nodes;
+    };
+
+    template <class T, class W>
+    SpanningForest<T, W>::SpanningForest()
+    { }
+
+    template <class T, class W>
+    SpanningForest<T, W>::SpanningForest(CompressedGraph<T, W>& graph)
+    : nodes(graph.nodes)
+    { }
+
+    template <class T, class W>
+    void SpanningForest<T, W>::addEdge(int from, int to, W weight){
+        edgeFrom.push_back(from);
+        edgeTo.push_back(to);
+        edgeWeight.push_back(weight);
+    }
+
+    template <class T, class W>
+    int SpanningForest<T, W>::size(){
+        return int(nodes.size());
+    }
+
+    template <class T, class W>
+    int SpanningForest<T, W>::numEdges(){
+        return int(edgeFrom.size());
+    }
+
+    template <class T, class W>
+    int SpanningForest<T, W>::numTrees(){
+        return size() - numEdges();
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance SpanningForest<T, W>::totalWeight(){
+        typename WeightTraits<W>::Distance total = 0;
+        for(auto weight : edgeWeight) total += weight;
+        return total;
+    }
+
+    template <class T, class W>
+    std::vector<std::tuple<Node<T>*, Node<T>*, W>> SpanningForest<T, W>::edges(){
+        std::vector<std::tuple<Node<T>*, Node<T>*, W>> forestEdges;
+        for(int e = 0; e < numEdges(); e++) forestEdges.push_back({nodes[edgeFrom[e]], nodes[edgeTo[e]], edgeWeight[e]});
+        return forestEdges;
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W> SpanningForest<T, W>::weightedGraph(){
+        WeightedGraph<T, W> graph;
+        for(auto node : nodes) graph.addNode(node, {});
+        for(int e = 0; e < numEdges(); e++) graph.addEdge(nodes[edgeFrom[e]], {nodes[edgeTo[e]], edgeWeight[e]});
+        return graph;
+    }
+}
+
+#endif // SPANNINGFOREST_HPP
@@ -97,6 +97,7 @@ namespace Graphify{
         // std::queue<Node<T>*> nodesToVisit;
         NodeVisitor<T> nodesToVisit("BFS"); // Maybe pull this magic string out later.. but nevertheless BFS will be used. 
         nodesToVisit.push(start);
+        visited.insert(start); // mark on push, so no node is queued (and re-parented) twice
         Node<T>* currentNode; 
 
         std::map<Node<T>*, int> distFromStart; 
@@ -114,15 +115,14 @@ namespace Graphify{
                     currentNode = previousNode[currentNode];
                 }
                 std::reverse(nodePath.begin(), nodePath.end());
-                return {distFromStart[currentNode], nodePath};
+                return {distFromStart[end], nodePath};
             }
 
-            visited.insert(currentNode);
-
             auto neighbors = graph[currentNode];
 
             for(auto neighbor : neighbors){
-                if(visited.find(currentNode) != visited.end()){
+                if(visited.find(neighbor) == visited.end()){
+                    visited.insert(neighbor);
                     nodesToVisit.push(neighbor);
                     distFromStart.insert(std::make_pair(neighbor, distFromStart[currentNode]+1));
                     previousNode[neighbor] = currentNode;
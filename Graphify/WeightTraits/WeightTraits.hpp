@@ -0,0 +1,35 @@
+#ifndef WEIGHTTRAITS_HPP
+#define WEIGHTTRAITS_HPP
+
+#include <limits>
+#include <type_traits>
+
+namespace Graphify{
+
+    /*
+        What the shortest path code needs to know about an edge weight type W, worked out at
+        compile time so a search over a WeightedGraph<T, W> picks its queue without looking at a
+        string or the weights.
+
+        Distances are summed in a wider type than the weights: a path over uint16_t weights
+        quickly outgrows 16 bits, and a few hundred int edges near INT_MAX overflow int. So every
+        integer weight sums in long long and floating point in double.
+
+            small integers (<= 16 bits)  => Dial's buckets, at most 65536 of them
+            wider integers               => radix heap
+            floating point               => indexed heap
+    */
+    template <class W>
+    struct WeightTraits{
+        static_assert(std::is_arithmetic<W>::value, "edge weights must be an arithmetic type");
+
+        using Distance = typename std::conditional<std::is_floating_point<W>::value, double, long long>::type;
+
+        static constexpr bool useBucketQueue = std::is_integral<W>::value && sizeof(W) <= 2;
+        static constexpr bool useRadixHeap = std::is_integral<W>::value && sizeof(W) > 2;
+
+        static constexpr Distance unreachable(){ return std::numeric_limits<Distance>::max(); }
+    };
+}
+
+#endif // WEIGHTTRAITS_HPP
@@ -7,11 +7,12 @@
 #include <vector>
 #include <iterator>
 #include <algorithm>
+#include <iostream>
 
 namespace Graphify{
 
 
-    template <class T>
+    template <class T, class W>
     class WeightedEdgeList;
 
     template <class T>
@@ -22,53 +23,71 @@ namespace Graphify{
     // Total Number of Components 
     // Min Dist Given Start: A, End: B
 
-    template <class T>
+    // One contiguous row major V x V block, so adjMat[i][j] is a single offset and whole rows can be streamed (and vectorized) over.
+    // W is the weight type, int unless asked otherwise.
+    // Rows used to be std::vector<int>&. operator[] now gives a Row view into the block instead, which still indexes, writes
+    // through, has size() and works in range for loops- but it's not a vector, so it can't be resized or bound to a vector&.
+    template <class T, class W = int>
     class WeightedAdjacencyMatrix{
         public:
-            WeightedAdjacencyMatrix(int V);
-            typename std::vector<int>& operator[](int i);
+            class Row{
+                public:
+                    Row(W* first, int V) : first(first), V(V) { }
+                    W& operator[](int j){ return first[j]; }
+                    int size(){ return V; }
+                    W* data(){ return first; }
+                    W* begin(){ return first; }
+                    W* end(){ return first + V; }
+
+                private:
+                    W* first;
+                    int V;
+            };
+
+            WeightedAdjacencyMatrix(int V, W fill=0);
+            Row operator[](int i);
             int size();
 
+            W* data(); // V * V weights, row i starts at data() + i * V
+
             void print();
 
 
         private:
-            std::vector<std::vector<int>> WeightedAdjMat;
+            std::vector<W> WeightedAdjMat;
             int V; 
 
 
     };
 
-    template <class T>
-    WeightedAdjacencyMatrix<T>::WeightedAdjacencyMatrix(int V)
-    : V(V)
-    {
-        for(int i = 0; i < V; i++){
-            WeightedAdjMat.resize(V);
-            for(int j = 0; j < V; j++){
-                WeightedAdjMat[i].resize(V);
-            }
-        }
-    }
+    template <class T, class W>
+    WeightedAdjacencyMatrix<T, W>::WeightedAdjacencyMatrix(int V, W fill)
+    : WeightedAdjMat((size_t)V * V, fill), V(V)
+    { }
 
-    template <class T>
-    typename std::vector<int>& WeightedAdjacencyMatrix<T>::operator[](int i){
+    template <class T, class W>
+    typename WeightedAdjacencyMatrix<T, W>::Row WeightedAdjacencyMatrix<T, W>::operator[](int i){
         ErrorHandling<T> handler;
-        handler.checkOOBWeightedAdjacencyMatrix(*this, i); // Pass current VALUE of instance of class to err handler..
-        return WeightedAdjMat[i];
+        handler.checkOOBWeightedAdjacencyMatrix(*this, i);
+        return Row(WeightedAdjMat.data() + (size_t)i * V, V);
 
     }
 
-    template <class T>
-    int WeightedAdjacencyMatrix<T>::size(){
+    template <class T, class W>
+    int WeightedAdjacencyMatrix<T, W>::size(){
         return V;
     }
 
-    template <class T>
-    void WeightedAdjacencyMatrix<T>::print(){
+    template <class T, class W>
+    W* WeightedAdjacencyMatrix<T, W>::data(){
+        return WeightedAdjMat.data();
+    }
+
+    template <class T, class W>
+    void WeightedAdjacencyMatrix<T, W>::print(){
         for(int i = 0; i < V; i++){
             for(int j = 0; j < V; j++){
-                std::cout << WeightedAdjMat[i][j] << " ";
+                std::cout << WeightedAdjMat[(size_t)i * V + j] << " ";
             }
             std::cout << "\n";
         }
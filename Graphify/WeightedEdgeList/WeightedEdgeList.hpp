@@ -15,66 +15,67 @@ namespace Graphify{
    template <class T>
     class ErrorHandling;
 
-    template <class T>
+    // W is the weight type, int unless asked otherwise
+    template <class T, class W = int>
     class WeightedEdgeList{
         public:
             WeightedEdgeList();
             WeightedEdgeList(bool directed);
-            std::tuple<Node<T>*, Node<T>*, int> &operator[](int i);
+            std::tuple<Node<T>*, Node<T>*, W> &operator[](int i);
 
-            void addEdge(Node<T>* node, Node<T>* baseNode, int weight);
-            void addEdge(std::tuple<Node<T>*, Node<T>*, int> edge); 
+            void addEdge(Node<T>* node, Node<T>* baseNode, W weight);
+            void addEdge(std::tuple<Node<T>*, Node<T>*, W> edge); 
 
-            WeightedGraph<T> weightedGraph();
+            WeightedGraph<T, W> weightedGraph();
 
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator find(Node<T>* node);
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator find(std::tuple<Node<T>*, Node<T>*, int> edge);
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator begin();
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator end();
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator rbegin();
-            typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator rend();
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator find(Node<T>* node);
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator find(std::tuple<Node<T>*, Node<T>*, W> edge);
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator begin();
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator end();
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator rbegin();
+            typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator rend();
 
-            void combine(WeightedEdgeList<T> edgeList);
+            void combine(WeightedEdgeList<T, W> edgeList);
 
             size_t size();
             void erase(Node<T>* node);
-            void erase(std::tuple<Node<T>*, Node<T>*, int> edge);
+            void erase(std::tuple<Node<T>*, Node<T>*, W> edge);
 
-            std::tuple<Node<T>*, Node<T>*, int> minEdge(); 
+            std::tuple<Node<T>*, Node<T>*, W> minEdge(); 
 
 
         private:
-            std::vector<std::tuple<Node<T>*, Node<T>*, int>> edgeList;
+            std::vector<std::tuple<Node<T>*, Node<T>*, W>> edgeList;
             bool directed; 
 
 
     };
 
-    template <class T>
-    WeightedEdgeList<T>::WeightedEdgeList()
+    template <class T, class W>
+    WeightedEdgeList<T, W>::WeightedEdgeList()
     { }
 
-    template <class T>
-    WeightedEdgeList<T>::WeightedEdgeList(bool directed)
+    template <class T, class W>
+    WeightedEdgeList<T, W>::WeightedEdgeList(bool directed)
     : directed(directed)
     { }
 
-    template <class T>
-    typename std::tuple<Node<T>*, Node<T>*, int>& WeightedEdgeList<T>::operator[](int i){
+    template <class T, class W>
+    typename std::tuple<Node<T>*, Node<T>*, W>& WeightedEdgeList<T, W>::operator[](int i){
         ErrorHandling<T> handler;
-        handler.checkOOBWeightedEdgeList(*this, i); // Pass current VALUE of instance of class to err handler..
+        handler.checkOOBWeightedEdgeList(*this, i); // Pass the current instance of class to err handler (by reference, not a copy of the whole graph)..
         return edgeList[i];
 
     }
 
-    template <class T>
-    void WeightedEdgeList<T>::addEdge(Node<T>* node, Node<T>* baseNode, int weight){
+    template <class T, class W>
+    void WeightedEdgeList<T, W>::addEdge(Node<T>* node, Node<T>* baseNode, W weight){
         edgeList.push_back({node, baseNode, weight});
         if(directed) edgeList.push_back({baseNode, node, weight});
     }
 
-    template <class T>
-    void WeightedEdgeList<T>::addEdge(std::tuple<Node<T>*, Node<T>*, int> edge){
+    template <class T, class W>
+    void WeightedEdgeList<T, W>::addEdge(std::tuple<Node<T>*, Node<T>*, W> edge){
         edgeList.push_back(edge);
         if(directed){
             std::swap(std::get<0>(edge), std::get<1>(edge));
@@ -82,10 +83,10 @@ namespace Graphify{
         }
     }
 
-    template <class T> 
-    WeightedGraph<T> WeightedEdgeList<T>::weightedGraph(){
+    template <class T, class W>
+    WeightedGraph<T, W> WeightedEdgeList<T, W>::weightedGraph(){
         // we could add a directed flag too.. 
-        WeightedGraph<T> graph; 
+        WeightedGraph<T, W> graph; 
         for(auto edge : edgeList){
             graph.addEdge(std::get<0>(edge), {std::get<1>(edge), std::get<2>(edge)});
         }
@@ -93,51 +94,51 @@ namespace Graphify{
         return graph; 
     }
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::find(Node<T>* node){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::find(Node<T>* node){
         for(auto it = this->begin(); it != this->end(); it++){
             if(std::get<0>(*it) == node || std::get<1>(*it) == node) return it; 
         }
         return this->end(); // return end iterator if nothing was found 
     }
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::find(std::tuple<Node<T>*, Node<T>*, int> edge){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::find(std::tuple<Node<T>*, Node<T>*, W> edge){
         return std::find(edgeList.begin(), edgeList.end(), edge);
     }
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::begin(){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::begin(){
         return edgeList.begin();
     }  
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::end(){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::end(){
         return edgeList.end();
     }
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::rbegin(){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::rbegin(){
         return edgeList.rbegin();
     }  
 
-    template <class T>
-    typename std::vector<std::tuple<Node<T>*, Node<T>*, int>>::iterator WeightedEdgeList<T>::rend(){
+    template <class T, class W>
+    typename std::vector<std::tuple<Node<T>*, Node<T>*, W>>::iterator WeightedEdgeList<T, W>::rend(){
         return edgeList.rend();
     }
 
-    template <class T>
-    size_t WeightedEdgeList<T>::size(){
+    template <class T, class W>
+    size_t WeightedEdgeList<T, W>::size(){
         return edgeList.size();
     }
 
-    template <class T>
-    void WeightedEdgeList<T>::combine(WeightedEdgeList<T> edgeList){
+    template <class T, class W>
+    void WeightedEdgeList<T, W>::combine(WeightedEdgeList<T, W> edgeList){
          this->edgeList.insert(this->end(), edgeList.begin(), edgeList.end());
     }
 
-    template <class T>
-    void WeightedEdgeList<T>::erase(Node<T>* node){
+    template <class T, class W>
+    void WeightedEdgeList<T, W>::erase(Node<T>* node){
         ErrorHandling<T> handler;
         handler.checkOOBWeightedEdgeList(*this, node);
 
@@ -150,13 +151,13 @@ namespace Graphify{
         }
     }
 
-    template <class T>
-    void WeightedEdgeList<T>::erase(std::tuple<Node<T>*, Node<T>*, int> edge){
+    template <class T, class W>
+    void WeightedEdgeList<T, W>::erase(std::tuple<Node<T>*, Node<T>*, W> edge){
         edgeList.erase(std::remove(edgeList.begin(), edgeList.end(), edge));
     }
 
-    template <class T>
-    std::tuple<Node<T>*, Node<T>*, int> WeightedEdgeList<T>::minEdge(){
+    template <class T, class W>
+    std::tuple<Node<T>*, Node<T>*, W> WeightedEdgeList<T, W>::minEdge(){
         return *std::min_element(edgeList.begin(), edgeList.end(), [](auto &left, auto &right) { return std::get<2>(left) < std::get<2>(right); });
     }
 }
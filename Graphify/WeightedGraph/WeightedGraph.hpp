@@ -6,6 +6,7 @@
 #include <iterator>
 #include <algorithm>
 #include "Node/Node.hpp"
+#include "MutationEpoch/MutationEpoch.hpp"
 #include "Graph/Graph.hpp"
 #include "WeightedAdjacencyMatrix/WeightedAdjacencyMatrix.hpp"
 
@@ -14,7 +15,7 @@
 namespace Graphify{
 
 
-    template <class T>
+    template <class T, class W>
     class WeightedEdgeList;
 
     // Min Component Size 
@@ -31,10 +32,17 @@ namespace Graphify{
     template <class T>
     class Graph;
 
-    template <class T>
+    // W is the weight type, int unless asked otherwise (say uint16_t to halve a CSR snapshot's weights, or int64_t/double)
+    template <class T, class W = int>
     class WeightedGraph{
         public:
-            std::vector<std::pair<Node<T>*, int>> &operator[](Node<T>* node);
+            WeightedGraph() = default;
+            WeightedGraph(const WeightedGraph<T, W>& other);
+            WeightedGraph(WeightedGraph<T, W>&& other);
+            WeightedGraph<T, W>& operator=(const WeightedGraph<T, W>& other);
+            WeightedGraph<T, W>& operator=(WeightedGraph<T, W>&& other);
+
+            std::vector<std::pair<Node<T>*, W>> &operator[](Node<T>* node);
 
             int outDegree(Node<T>* node);
             int maximumOutDegree();
@@ -42,66 +50,100 @@ namespace Graphify{
             int inDegree(Node<T>* node);
             int maximumInDegree();
 
-            void addNode(Node<T>* node, std::vector<std::pair<Node<T>*, int>> nodeAdjList);
-            void addEdge(Node<T>* node, std::pair<Node<T>*, int> nodeAdjList);
+            void addNode(Node<T>* node, std::vector<std::pair<Node<T>*, W>> nodeAdjList);
+            void addEdge(Node<T>* node, std::pair<Node<T>*, W> nodeAdjList);
 
-            void setWeight(Node<T>* node, Node<T>* baseNode, int newWeight);
-            int getWeight(Node <T>* node, Node<T>* baseNode);
+            void setWeight(Node<T>* node, Node<T>* baseNode, W newWeight);
+            W getWeight(Node <T>* node, Node<T>* baseNode);
 
-            WeightedEdgeList<T> weightedEdgeList();
+            WeightedEdgeList<T, W> weightedEdgeList();
             Graph<T> unweightedGraph();
-            std::tuple<WeightedAdjacencyMatrix<T>, std::map<Node<T>*, int>> weightedAdjacencyMatrix();
+            std::tuple<WeightedAdjacencyMatrix<T, W>, std::map<Node<T>*, int>> weightedAdjacencyMatrix();
 
-            void complete(std::vector<Node<T>*> nodes, std::vector<int> weights);
+            void complete(std::vector<Node<T>*> nodes, std::vector<W> weights);
             void transpose();
 
-            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator find(Node<T>* node);
-            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator begin();
-            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator end();
-            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator rbegin();
-            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator rend();
+            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator find(Node<T>* node);
+            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator begin();
+            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator end();
+            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator rbegin();
+            typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator rend();
 
             size_t size();
             void erase(Node<T>* node);
 
+            // changed by every mutating member and by copies/assignment (but not by writes through
+            // operator[]), so indexes and caches built from this graph can tell when they have gone stale
+            size_t mutationEpoch();
+
             std::vector<Node<T>*> getAllNodes();
 
-            void scalarMultiply(int a);
+            void scalarMultiply(W a);
 
 
         private:
-            std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>> WeightedGraph;
+            std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>> weightedGraph;
+            size_t epoch = nextMutationEpoch();
 
 
     };
 
-    template <class T>
-    typename std::vector<std::pair<Node<T>*, int>>& WeightedGraph<T>::operator[](Node<T>* node){
+    // the epoch is never copied, see Graph
+    template <class T, class W>
+    WeightedGraph<T, W>::WeightedGraph(const WeightedGraph<T, W>& other)
+    : weightedGraph(other.weightedGraph)
+    {
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W>::WeightedGraph(WeightedGraph<T, W>&& other)
+    : weightedGraph(std::move(other.weightedGraph))
+    {
+        other.epoch = nextMutationEpoch();
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W>& WeightedGraph<T, W>::operator=(const WeightedGraph<T, W>& other){
+        weightedGraph = other.weightedGraph;
+        epoch = nextMutationEpoch();
+        return *this;
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W>& WeightedGraph<T, W>::operator=(WeightedGraph<T, W>&& other){
+        weightedGraph = std::move(other.weightedGraph);
+        epoch = nextMutationEpoch();
+        other.epoch = nextMutationEpoch();
+        return *this;
+    }
+
+    template <class T, class W>
+    typename std::vector<std::pair<Node<T>*, W>>& WeightedGraph<T, W>::operator[](Node<T>* node){
         ErrorHandling<T> handler;
-        handler.checkOOBWeightedAdjList(*this, node); // Pass current VALUE of instance of class to err handler..
-        return WeightedGraph[node];
+        handler.checkOOBWeightedAdjList(*this, node); // Pass the current instance of class to err handler (by reference, not a copy of the whole graph)..
+        return weightedGraph[node];
 
     }
 
-    template <class T>
-    int WeightedGraph<T>::outDegree(Node<T>* node){
+    template <class T, class W>
+    int WeightedGraph<T, W>::outDegree(Node<T>* node){
         // vector.size() returns a size_t.. the cast is to be explicit about what we are returning
-        return int(WeightedGraph[node].size()); 
+        return int(weightedGraph[node].size()); 
     }
     
-    template <class T>
-    int WeightedGraph<T>::maximumOutDegree(){ 
+    template <class T, class W>
+    int WeightedGraph<T, W>::maximumOutDegree(){ 
         int maxOutDegree = 0;
-        for(auto [start, nodeAdjList] : WeightedGraph){
+        for(auto [start, nodeAdjList] : weightedGraph){
             maxOutDegree = std::max(maxOutDegree, int(nodeAdjList.size()));
         }
         return maxOutDegree;
     }
 
-    template <class T>
-    int WeightedGraph<T>::inDegree(Node<T>* node){
+    template <class T, class W>
+    int WeightedGraph<T, W>::inDegree(Node<T>* node){
         int nodeInDegree = 0; 
-        for(auto [start, nodeAdjList] : WeightedGraph){
+        for(auto [start, nodeAdjList] : weightedGraph){
             bool found = false; 
             for(auto [baseNode, weight] : nodeAdjList){
                 if(node == baseNode){
@@ -113,26 +155,28 @@ namespace Graphify{
         return nodeInDegree;
     }
 
-    template <class T>
-    int WeightedGraph<T>::maximumInDegree(){
+    template <class T, class W>
+    int WeightedGraph<T, W>::maximumInDegree(){
         int maxInDegree = 0;
-        for(auto [start, nodeAdjList] : WeightedGraph) maxInDegree = std::max(maxInDegree, inDegree(start));
+        for(auto [start, nodeAdjList] : weightedGraph) maxInDegree = std::max(maxInDegree, inDegree(start));
         return maxInDegree;
     }
 
-    template <class T>
-    void WeightedGraph<T>::addNode(Node<T>* node, std::vector<std::pair<Node<T>*, int>> nodeAdjList){
-        WeightedGraph.insert(std::make_pair(node, nodeAdjList));
+    template <class T, class W>
+    void WeightedGraph<T, W>::addNode(Node<T>* node, std::vector<std::pair<Node<T>*, W>> nodeAdjList){
+        weightedGraph.insert(std::make_pair(node, nodeAdjList));
+        epoch = nextMutationEpoch();
     }
 
-    template <class T>
-    void WeightedGraph<T>::addEdge(Node<T>* node, std::pair<Node<T>*, int> nodeAdjList){
-        WeightedGraph[node].push_back(nodeAdjList);
+    template <class T, class W>
+    void WeightedGraph<T, W>::addEdge(Node<T>* node, std::pair<Node<T>*, W> nodeAdjList){
+        weightedGraph[node].push_back(nodeAdjList);
+        epoch = nextMutationEpoch();
     }
 
-    template <class T>
-    int WeightedGraph<T>::getWeight(Node <T>* node, Node<T>* baseNode){
-        for(auto [iterateNode, weight] : WeightedGraph[node]){
+    template <class T, class W>
+    W WeightedGraph<T, W>::getWeight(Node <T>* node, Node<T>* baseNode){
+        for(auto [iterateNode, weight] : weightedGraph[node]){
             if(iterateNode == baseNode){
                 return weight;
             }
@@ -140,22 +184,23 @@ namespace Graphify{
         // throw not found error!
     }
 
-    template <class T>
-    void WeightedGraph<T>::setWeight(Node <T>* node, Node<T>* baseNode, int newWeight){
-        for(auto it = WeightedGraph[node].begin(); it != WeightedGraph[node].end(); it++){
+    template <class T, class W>
+    void WeightedGraph<T, W>::setWeight(Node <T>* node, Node<T>* baseNode, W newWeight){
+        for(auto it = weightedGraph[node].begin(); it != weightedGraph[node].end(); it++){
             if(it->first == baseNode){
-                WeightedGraph[node].erase(it);
-                WeightedGraph[node].push_back({baseNode, newWeight});
+                weightedGraph[node].erase(it);
+                weightedGraph[node].push_back({baseNode, newWeight});
+                epoch = nextMutationEpoch();
 
                 return; // we are done here. 
             }
         }
     }
 
-    template <class T>
-    WeightedEdgeList<T>  WeightedGraph<T>::weightedEdgeList(){
-        WeightedEdgeList<T> edgeList; 
-        for(auto [node, nodeAdjList] : WeightedGraph){
+    template <class T, class W>
+    WeightedEdgeList<T, W>  WeightedGraph<T, W>::weightedEdgeList(){
+        WeightedEdgeList<T, W> edgeList; 
+        for(auto [node, nodeAdjList] : weightedGraph){
             for(auto [baseNode, weight] : nodeAdjList){
                 edgeList.addEdge({node, baseNode, weight});
             }
@@ -163,11 +208,11 @@ namespace Graphify{
         return edgeList;
     }
 
-    template <class T>
-    Graph<T> WeightedGraph<T>::unweightedGraph(){
+    template <class T, class W>
+    Graph<T> WeightedGraph<T, W>::unweightedGraph(){
         Graph<T> unweightedGraph; 
 
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             std::vector<Node<T>*> unweightedNodeAdjList; 
             for(auto [baseNode, weight] : nodeAdjList){
                 unweightedNodeAdjList.push_back(baseNode);
@@ -177,18 +222,18 @@ namespace Graphify{
         return unweightedGraph;
     }
 
-    template <class T>
-    std::tuple<WeightedAdjacencyMatrix<T>, std::map<Node<T>*, int>> WeightedGraph<T>::weightedAdjacencyMatrix(){
-        WeightedAdjacencyMatrix<T> weightedAdjMat(WeightedGraph.size()); 
+    template <class T, class W>
+    std::tuple<WeightedAdjacencyMatrix<T, W>, std::map<Node<T>*, int>> WeightedGraph<T, W>::weightedAdjacencyMatrix(){
+        WeightedAdjacencyMatrix<T, W> weightedAdjMat(weightedGraph.size()); 
         std::map<Node<T>*, int> nodeToIndex; 
 
         int i = 0; 
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             nodeToIndex.insert(std::make_pair(node, i));
             i++;
         }
 
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             nodeToIndex.insert(std::make_pair(node, i));
             int j = 0; 
             for(auto [baseNode, weight] : nodeAdjList){
@@ -199,11 +244,11 @@ namespace Graphify{
         return {weightedAdjMat, nodeToIndex};
     }
 
-    template <class T>
-    void WeightedGraph<T>::complete(std::vector<Node<T>*> nodes, std::vector<int> weights){
+    template <class T, class W>
+    void WeightedGraph<T, W>::complete(std::vector<Node<T>*> nodes, std::vector<W> weights){
         // add error handling- nodes.size() must = k!
 
-        std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>> weightedCompleteGraph;
+        std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>> weightedCompleteGraph;
         
         for(auto node : nodes){
             for(int i = 0; i < nodes.size(); i++){ // O( (|V|)^2 ) algorithm.. n(n-1)/2 connections..
@@ -212,63 +257,65 @@ namespace Graphify{
             }
         }
 
-        WeightedGraph = weightedCompleteGraph;
+        weightedGraph = weightedCompleteGraph;
+        epoch = nextMutationEpoch();
 
     }
 
-    template <class T>
-    void WeightedGraph<T>::transpose(){
-        std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>> transposedWeightedGraph;
+    template <class T, class W>
+    void WeightedGraph<T, W>::transpose(){
+        std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>> transposedWeightedGraph;
         
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             for(auto [baseNode, weight] : nodeAdjList){
                 transposedWeightedGraph[baseNode].push_back({node, weight});
             }
         }
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             if(transposedWeightedGraph.find(node) == transposedWeightedGraph.end()) transposedWeightedGraph[node] = {};
         }
-        WeightedGraph = transposedWeightedGraph;
+        weightedGraph = transposedWeightedGraph;
+        epoch = nextMutationEpoch();
     }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator WeightedGraph<T>::find(Node<T>* node){
-        return WeightedGraph.find(node);
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator WeightedGraph<T, W>::find(Node<T>* node){
+        return weightedGraph.find(node);
     }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator WeightedGraph<T>::begin(){
-        return WeightedGraph.begin();
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator WeightedGraph<T, W>::begin(){
+        return weightedGraph.begin();
     }  
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator WeightedGraph<T>::end(){
-        return WeightedGraph.end();
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator WeightedGraph<T, W>::end(){
+        return weightedGraph.end();
     }
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator WeightedGraph<T>::rbegin(){
-        return WeightedGraph.rbegin();
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator WeightedGraph<T, W>::rbegin(){
+        return weightedGraph.rbegin();
     }  
 
-    template <class T>
-    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, int>>>::iterator WeightedGraph<T>::rend(){
-        return WeightedGraph.rend();
+    template <class T, class W>
+    typename std::map<Node<T>*, std::vector<std::pair<Node<T>*, W>>>::iterator WeightedGraph<T, W>::rend(){
+        return weightedGraph.rend();
     }
 
-    template <class T>
-    size_t WeightedGraph<T>::size(){
-        return WeightedGraph.size();
+    template <class T, class W>
+    size_t WeightedGraph<T, W>::size(){
+        return weightedGraph.size();
     }
 
-    template <class T>
-    void WeightedGraph<T>::erase(Node<T>* node){
+    template <class T, class W>
+    void WeightedGraph<T, W>::erase(Node<T>* node){
         // ErrorHandling<T> handler;
         // handler.checkOOBWeightedAdjList(*this, node);
 
-        WeightedGraph.erase(node);
+        weightedGraph.erase(node);
 
-        for(auto [start, nodeAdjList] : WeightedGraph){
+        for(auto [start, nodeAdjList] : weightedGraph){
             for(auto it = nodeAdjList.begin(); it != nodeAdjList.end();){
                 if(it->first == node){
                     nodeAdjList.erase(it);
@@ -276,20 +323,26 @@ namespace Graphify{
                 else{ ++it; }
             }
         }
+        epoch = nextMutationEpoch();
     }
 
-    template <class T>
-    std::vector<Node<T>*> WeightedGraph<T>::getAllNodes(){
+    template <class T, class W>
+    size_t WeightedGraph<T, W>::mutationEpoch(){
+        return epoch;
+    }
+
+    template <class T, class W>
+    std::vector<Node<T>*> WeightedGraph<T, W>::getAllNodes(){
         std::vector<Node<T>*> nodes; 
-        for(auto [node, nodeAdjList] : WeightedGraph){
+        for(auto [node, nodeAdjList] : weightedGraph){
             nodes.push_back(node);
         }
         return nodes; 
     }
 
-    template <class T>
-    void WeightedGraph<T>::scalarMultiply(int a){
-        for(auto [node, nodeAdjList] : WeightedGraph){
+    template <class T, class W>
+    void WeightedGraph<T, W>::scalarMultiply(W a){
+        for(auto [node, nodeAdjList] : weightedGraph){
             for(auto [baseNode, weight] : nodeAdjList){
                 setWeight(node, baseNode, -weight);
             }
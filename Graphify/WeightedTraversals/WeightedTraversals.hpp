@@ -7,6 +7,17 @@
 #include "NodeVisitor/NodeVisitor.hpp"
 #include "Graph/Graph.hpp"
 #include "Node/Node.hpp"
+#include "ReachabilityIndex/ReachabilityIndex.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "IndexedHeap/IndexedHeap.hpp"
+#include "BucketQueue/BucketQueue.hpp"
+#include "RadixHeap/RadixHeap.hpp"
+#include "Parallel/Parallel.hpp"
+#include "ShortestPathTree/ShortestPathTree.hpp"
+#include "DisjointSet/DisjointSet.hpp"
+#include "SpanningForest/SpanningForest.hpp"
+#include "WeightTraits/WeightTraits.hpp"
+#include "ErrorHandling/ErrorHandling.hpp"
 #include <set>
 #include <unordered_set>
 #include <map>
@@ -14,49 +25,295 @@
 #include <tuple>
 #include <vector>
 #include <iterator>
+#include <climits>
+#include <atomic>
+#include <queue>
+#include <deque>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace Graphify{
     template <class T>
     class Node;
 
-    template <class T>
+    /*
+        W is the edge weight type of the graphs searched (int unless asked otherwise), and path
+        lengths and distances are Distance = WeightTraits<W>::Distance: long long for integer
+        weights, so sums of int weights can't overflow, and double for floating point ones.
+        Unreachable is the largest Distance, or -1 / {} where a method returns a single path.
+        A CompressedGraph snapshot of an unweighted Graph is searched as if every edge weighed 1.
+    */
+    template <class T, class W = int>
     class WeightedTraversals{
         public:
-            std::vector<std::string> validTraversalMethods(); // => ['DFS', 'BFS', 'UCS']
+            typedef typename WeightTraits<W>::Distance Distance;
+
+            WeightedTraversals();
 
-            bool doesPathExist(WeightedGraph<T> graph, Node<T>* start, Node<T>* end);
-            std::tuple<int, std::vector<Node<T>*>> DAGShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end);
-            std::tuple<int, std::vector<Node<T>*>> DAGLongestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end);
-            std::tuple<int, std::vector<Node<T>*>> djikstraShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end);
-            std::tuple<int, std::vector<Node<T>*>> alphaStarShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end, std::map<Node<T>*, int> h);
-            std::tuple<int, std::vector<Node<T>*>> bellmanFordShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end);
-            std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, int>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> floydWarshall(WeightedGraph<T> graph);
-            std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, int>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> johnson(WeightedGraph<T> graph);
+            std::vector<std::string> validTraversalMethods(); // => ['DFS', 'BFS', 'UCS']
 
-            int travellingSalesmanProblem(WeightedGraph<T> graph, Node<T>* start);
+            // With an index attached, doesPathExist (and so the pre-check in every shortest path method)
+            // is answered from the index instead of a BFS. The index must be built from the graph being queried.
+            void setReachabilityIndex(ReachabilityIndex<T, W>* index);
+
+            bool doesPathExist(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end);
+            std::tuple<Distance, std::vector<Node<T>*>> DAGShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end);
+            std::tuple<Distance, std::vector<Node<T>*>> DAGLongestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end);
+            // queueMethod: "auto" (pick by weight type and range), "heap" (indexed 4-ary heap), "buckets" (Dial) or "radix" (radix heap).
+            // "buckets" turns into "radix" past MAX_BUCKET_QUEUE_BUCKETS buckets, and negative or floating point weights always get the heap.
+            std::vector<std::string> validQueueMethods(); // => ['auto', 'heap', 'buckets', 'radix']
+            std::tuple<Distance, std::vector<Node<T>*>> djikstraShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end, std::string queueMethod="auto");
+            std::tuple<Distance, std::vector<Node<T>*>> djikstraShortestPath(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, std::string queueMethod="auto");
+            // Searches from both ends at once (non-negative weights). The CSR version takes reverseGraph = graph.transposed() so it can be reused across queries.
+            std::tuple<Distance, std::vector<Node<T>*>> bidirectionalDjikstraShortestPath(WeightedGraph<T, W>& graph, Node<T>* start, Node<T>* end);
+            std::tuple<Distance, std::vector<Node<T>*>> bidirectionalDjikstraShortestPath(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& reverseGraph, Node<T>* start, Node<T>* end);
+            // Yen's k shortest loopless paths (non-negative weights), shortest first, fewer if there aren't k. Spur searches run in parallel.
+            std::vector<std::tuple<Distance, std::vector<Node<T>*>>> kShortestPaths(WeightedGraph<T, W>& graph, Node<T>* start, Node<T>* end, int k, int numThreads=0);
+            std::vector<std::tuple<Distance, std::vector<Node<T>*>>> kShortestPaths(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, int k, int numThreads=0);
+
+            // One-to-all versions: one search from start, then ask the tree for any number of targets.
+            ShortestPathTree<T, Distance> djikstraShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start, std::string queueMethod="auto");
+            ShortestPathTree<T, Distance> djikstraShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, std::string queueMethod="auto");
+            ShortestPathTree<T, Distance> bellmanFordShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start);
+            ShortestPathTree<T, Distance> bellmanFordShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start);
+            // queue based Bellman-Ford, only rescans nodes whose distance just changed
+            ShortestPathTree<T, Distance> spfaShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start);
+            ShortestPathTree<T, Distance> spfaShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start);
+            // rounds over a flat edge list split across threads, distances lowered with atomic min
+            ShortestPathTree<T, Distance> parallelBellmanFordShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start, int numThreads=0);
+            ShortestPathTree<T, Distance> parallelBellmanFordShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, int numThreads=0);
+            ShortestPathTree<T, Distance> DAGShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start); // nodes on a cycle are left unreachable
+            ShortestPathTree<T, Distance> DAGShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start);
+            ShortestPathTree<T, Distance> DAGLongestPathTree(WeightedGraph<T, W>& graph, Node<T>* start);
+            ShortestPathTree<T, Distance> DAGLongestPathTree(CompressedGraph<T, W>& graph, Node<T>* start);
+            // Vertex weighted: nodeWeights[i] (by CSR index, empty = all 0) counts for every node on a path, start included.
+            // The DAG is relaxed a level at a time, each level spread over numThreads.
+            ShortestPathTree<T, Distance> DAGShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, const std::vector<W>& nodeWeights, int numThreads=0);
+            ShortestPathTree<T, Distance> DAGLongestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, const std::vector<W>& nodeWeights, int numThreads=0);
+            // The longest path starting anywhere (nodeWeights as task durations) => {length, path}, {-1, {}} if the graph has a cycle
+            std::tuple<Distance, std::vector<Node<T>*>> criticalPath(CompressedGraph<T, W>& graph, const std::vector<W>& nodeWeights, int numThreads=0);
+
+            // Parallel one-to-all shortest paths (non-negative weights, negative ones are reported and leave just the source in the tree).
+            // delta is the bucket width, 0 picks one from the weights and degrees. It's widened if it would need more than MAX_BUCKET_QUEUE_BUCKETS buckets.
+            ShortestPathTree<T, Distance> deltaSteppingShortestPaths(WeightedGraph<T, W>& graph, Node<T>* start, W delta=0, int numThreads=0);
+            ShortestPathTree<T, Distance> deltaSteppingShortestPaths(CompressedGraph<T, W>& graph, Node<T>* start, W delta=0, int numThreads=0);
+
+            // h[node] must never overestimate the distance from node to end (missing nodes count as 0), H is any number type
+            template <class H>
+            std::tuple<Distance, std::vector<Node<T>*>> alphaStarShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end, const std::map<Node<T>*, H>& h);
+            // heuristic(i) => lower bound on the distance from CSR node i to end, e.g. Landmarks<T, W>::heuristicTo(end). Taken by value so it inlines.
+            template <class Heuristic>
+            std::tuple<Distance, std::vector<Node<T>*>> alphaStarShortestPath(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, Heuristic heuristic);
+            std::tuple<Distance, std::vector<Node<T>*>> bellmanFordShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end);
+            std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, Distance>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> floydWarshall(WeightedGraph<T, W> graph);
+            std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, Distance>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> johnson(WeightedGraph<T, W> graph);
+
+            // Dense all pairs on a V x V weight matrix => {distances, next hops}. Unreachable pairs are the largest Distance / -1.
+            // A negative cycle is reported and both matrices come back empty (size 0), like johnsonMatrix.
+            // Entries equal to noEdge (or the largest W) are missing edges. The CSR version numbers rows by CSR index.
+            std::tuple<WeightedAdjacencyMatrix<T, Distance>, WeightedAdjacencyMatrix<T>> floydWarshallMatrix(WeightedAdjacencyMatrix<T, W>& adjMat, W noEdge=0, int numThreads=0);
+            std::tuple<WeightedAdjacencyMatrix<T, Distance>, WeightedAdjacencyMatrix<T>> floydWarshallMatrix(CompressedGraph<T, W>& graph, int numThreads=0);
+            std::vector<int> nextHopPath(WeightedAdjacencyMatrix<T>& nextHop, int from, int to); // from .. to, {} if unreachable
+
+            // Sparse all pairs (negative weights allowed): one Dijkstra per source, sources spread over numThreads.
+            // => {distances, predecessors} by CSR index, the largest Distance / -1 if unreachable. predecessors is empty (size 0)
+            // unless withPredecessors, and both are empty if there's a negative cycle (which is reported).
+            std::tuple<WeightedAdjacencyMatrix<T, Distance>, WeightedAdjacencyMatrix<T>> johnsonMatrix(CompressedGraph<T, W>& graph, bool withPredecessors=false, int numThreads=0);
+            std::vector<int> predecessorPath(WeightedAdjacencyMatrix<T>& predecessor, int from, int to); // from .. to, {} if unreachable
+
+            // Tour lengths are Distance.
+            Distance travellingSalesmanProblem(WeightedGraph<T, W> graph, Node<T>* start); // => -1 if there is no tour
+            // Exact tours (Held-Karp), => {length, start .. start} or {-1, {}} if there is no tour. Exponential, so only up to
+            // MAX_HELD_KARP_NODES nodes- bigger graphs are reported and get approximateTravellingSalesmanTour's best tour after its
+            // default 1 second instead, which is a tour but not necessarily the shortest one. Entries equal to noEdge (or the largest W) are missing edges.
+            std::tuple<Distance, std::vector<int>> travellingSalesmanTour(WeightedAdjacencyMatrix<T, W>& adjMat, int start=0, W noEdge=0, int numThreads=0);
+            std::tuple<Distance, std::vector<Node<T>*>> travellingSalesmanTour(WeightedGraph<T, W>& graph, Node<T>* start, int numThreads=0);
+            static const int MAX_HELD_KARP_NODES = 20; // 2^19 subsets x 19 Distances is ~80MB, every node more doubles it
+            // Heuristic tours for anything bigger: nearest neighbor, then 2-opt/Or-opt with restarts until timeLimitSeconds
+            // runs out. => the best tour found {length, start .. start}, or {-1, {}} if it still needs a missing edge.
+            std::tuple<Distance, std::vector<int>> approximateTravellingSalesmanTour(WeightedAdjacencyMatrix<T, W>& adjMat, int start=0, double timeLimitSeconds=1.0, W noEdge=0, unsigned seed=0);
+            std::tuple<Distance, std::vector<Node<T>*>> approximateTravellingSalesmanTour(WeightedGraph<T, W>& graph, Node<T>* start, double timeLimitSeconds=1.0, unsigned seed=0);
 
             // MSTs
-            WeightedGraph<T> kruskalMinimumSpanningTree(WeightedGraph<T> graph);
-            WeightedGraph<T> primMinimumSpanningTree(WeightedGraph<T> graph);
+            WeightedGraph<T, W> kruskalMinimumSpanningTree(WeightedGraph<T, W> graph);
+            WeightedGraph<T, W> primMinimumSpanningTree(WeightedGraph<T, W> graph);
+
+            // Minimum spanning forests: edge directions are ignored, and there's one tree per component
+            // kruskalMethod: "sort" (sort every edge, in parallel) or "filter" (Filter-Kruskal, skips sorting edges that would close a cycle anyway)
+            std::vector<std::string> validKruskalMethods(); // => ['sort', 'filter']
+            SpanningForest<T, W> kruskalMinimumSpanningForest(WeightedGraph<T, W>& graph, std::string kruskalMethod="sort", int numThreads=0);
+            SpanningForest<T, W> kruskalMinimumSpanningForest(CompressedGraph<T, W>& graph, std::string kruskalMethod="sort", int numThreads=0);
+            SpanningForest<T, W> primMinimumSpanningForest(WeightedGraph<T, W>& graph);
+            SpanningForest<T, W> primMinimumSpanningForest(CompressedGraph<T, W>& graph);
+            SpanningForest<T, W> boruvkaMinimumSpanningForest(WeightedGraph<T, W>& graph, int numThreads=0);
+            SpanningForest<T, W> boruvkaMinimumSpanningForest(CompressedGraph<T, W>& graph, int numThreads=0);
 
         private:
-
-            int travellingSalesmanProblemRecurse(Node<T>* start, Node<T>* node, std::vector<Node<T>*>& nodesLeft, WeightedAdjacencyMatrix<T>& adjMat, std::map<Node<T>*, int>& nodeToIndex);
+            ReachabilityIndex<T, W>* reachabilityIndex;
+
+            // Dial's buckets pay for maxWeight + 1 buckets per search, so past this the radix heap wins
+            static const int MAX_BUCKET_QUEUE_WEIGHT = 1 << 12;
+            // .. and past this even an explicit "buckets" gets the radix heap, 2^20 empty buckets are already ~24MB
+            static const int MAX_BUCKET_QUEUE_BUCKETS = 1 << 20;
+
+            std::string pickQueueMethod(CompressedGraph<T, W>& graph, std::string queueMethod);
+            bool rejectNegativeWeights(CompressedGraph<T, W>& graph); // => true (and reported) if the graph has a negative weight
+            void dijkstra(CompressedGraph<T, W>& graph, int source, int target, std::string queueMethod, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode);
+            // templated on the graph's weights too, Johnson searches a copy reweighted into Distance
+            template <class EdgeWeight, class D>
+            void heapDijkstra(CompressedGraph<T, EdgeWeight>& graph, int source, int target, std::vector<D>& nodeDistance, std::vector<int>& previousNode);
+            template <class Queue>
+            void monotoneQueueDijkstra(CompressedGraph<T, W>& graph, int source, int target, Queue& nodesToVisit, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode);
+
+            W defaultDelta(CompressedGraph<T, W>& graph);
+            bool bellmanFord(CompressedGraph<T, W>& graph, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode);
+            bool spfa(CompressedGraph<T, W>& graph, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode);
+            // source == -1 starts from every node without incoming edges. => false if some nodes are on or behind a cycle
+            bool DAGPaths(CompressedGraph<T, W>& graph, int source, const std::vector<W>& nodeWeights, bool longest, int numThreads, ShortestPathTree<T, Distance>& tree);
+
+            /*
+                The parallel searches (delta-stepping, parallel Bellman-Ford, the level parallel DAG) lower
+                a node's distance and parent together with one 64 bit CAS, so the distance has to fit in
+                32 bits. That's checked as they go: a distance past int (or a floating point W) has them
+                start over with the serial version, which keeps the whole Distance.
+            */
+            static const bool PACKED_DISTANCES = std::is_integral<W>::value;
+            static unsigned long long packLabel(long long nodeDistance, int previousNode){ return (unsigned long long)((unsigned int)nodeDistance ^ 0x80000000u) << 32 | (unsigned int)previousNode; }
+            static long long labelDistance(unsigned long long label){ return int((unsigned int)(label >> 32) ^ 0x80000000u); }
+            static bool fitsLabel(long long nodeDistance){ return nodeDistance > INT_MIN && nodeDistance < INT_MAX; } // INT_MAX is left for UNREACHED
+
+            // a path found by Yen's algorithm, with the distance to every node on it, and the index where it left the path it was spurred from
+            struct RankedPath{
+                Distance length;
+                std::vector<int> nodes;
+                std::vector<Distance> prefixLength;
+                int deviation;
+
+                bool operator>(const RankedPath& other) const { return std::tie(length, nodes) > std::tie(other.length, other.nodes); }
+            };
+
+            /*
+                Scratch arrays for one thread's spur searches. Everything is stamped with the number of
+                the search it belongs to, so starting a new search (and forgetting the blocked nodes and
+                edges of the last one) is just search++, not clearing V + E entries.
+            */
+            struct SpurWorkspace{
+                int search = 0; // bumped by the caller before blocking anything for the next search
+                std::vector<int> seen; // seen[v] == search => nodeDistance[v], previousNode[v] are from this search
+                std::vector<Distance> nodeDistance;
+                std::vector<int> previousNode;
+                std::vector<int> blockedNode;
+                std::vector<int> blockedEdge;
+                IndexedHeap<Distance> nodesToVisit;
+            };
+
+            bool spurDijkstra(CompressedGraph<T, W>& graph, int source, int target, SpurWorkspace& workspace, RankedPath& spur);
+
+            // 64 x 64 ints is 16KB a tile, so the three tiles one update touches stay in L1/L2
+            static const int FLOYD_WARSHALL_BLOCK = 64;
+            // Floyd-Warshall runs in int (and so in SIMD) whenever no distance can leave (-INF, INF), else in Distance
+            template <class D>
+            bool blockedFloydWarshall(std::vector<D>& distance, std::vector<int>& nextHop, int N, int numThreads);
+            template <class D>
+            static D floydWarshallInfinity(){ return std::numeric_limits<D>::max() / 2; } // INF + INF still fits in a D
+            template <class D>
+            static void minPlusBlock(D* distance, int* nextHop, int stride, int iBlock, int jBlock, int kBlock);
+
+            // the largest EdgeWeight where there's no edge, lightest of any parallel edges
+            template <class EdgeWeight>
+            WeightedAdjacencyMatrix<T, EdgeWeight> denseWeights(CompressedGraph<T, EdgeWeight>& graph);
+
+            /*
+                (weight, edge index) as one integer that orders by weight, then index. Weights of 32 bits or
+                less go in as they are, with the sign bit flipped so negative weights sort first- wider or
+                floating point ones are replaced by their rank among the distinct weights, which orders the
+                same. weightKeys gives every edge's 32 bit weight part.
+            */
+            static const bool DIRECT_WEIGHT_KEYS = std::is_integral<W>::value && (sizeof(W) < 4 || (sizeof(W) == 4 && std::is_signed<W>::value));
+            std::vector<unsigned int> weightKeys(CompressedGraph<T, W>& graph, int numThreads);
+            static unsigned long long edgeKey(unsigned int weightKey, int e){ return (unsigned long long)weightKey << 32 | (unsigned int)e; }
+            static int edgeOf(unsigned long long key){ return int(key & 0xffffffffu); }
+
+            static const int FILTER_KRUSKAL_THRESHOLD = 1 << 10; // below this many edges just sort them
+            void filterKruskal(CompressedGraph<T, W>& graph, std::vector<int>& edgeSource, unsigned long long* begin, unsigned long long* end, DisjointSet& trees, SpanningForest<T, W>& forest, std::mt19937& rng);
+
+            /*
+                A tour being improved by local search: the visiting order plus where each node
+                sits in it, a few nearest neighbors per node to draw moves from, and the queue of
+                nodes whose don't-look bit is off (queued = bit off).
+            */
+            struct LocalSearchTour{
+                int V;
+                const W* weights;
+                W noEdge;
+                Distance missingCost;
+                bool symmetric; // 2-opt and reversed Or-opt moves flip a stretch of the tour, which only keeps its cost if w(u, v) = w(v, u)
+
+                int numNeighbors;
+                std::vector<int> neighbors; // [node * numNeighbors + i], nearest first
+
+                std::vector<int> order;
+                std::vector<int> position;
+
+                std::deque<int> active;
+                std::vector<char> queued;
+
+                bool isEdge(int u, int v){
+                    W w = weights[(size_t)u * V + v];
+                    return w != noEdge && w < std::numeric_limits<W>::max();
+                }
+                // a missing edge is just very expensive, so the search walks away from it on its own
+                Distance cost(int u, int v){ return isEdge(u, v) ? Distance(weights[(size_t)u * V + v]) : missingCost; }
+                int next(int node){ return order[position[node] + 1 == V ? 0 : position[node] + 1]; }
+                int previous(int node){ return order[position[node] == 0 ? V - 1 : position[node] - 1]; }
+                void activate(int node){
+                    if(queued[node]) return;
+                    queued[node] = 1;
+                    active.push_back(node);
+                }
+            };
+
+            void setTourOrder(LocalSearchTour& tour, const std::vector<int>& order);
+            Distance tourCost(LocalSearchTour& tour);
+            bool localSearch(LocalSearchTour& tour, std::chrono::steady_clock::time_point deadline); // => false if it ran out of time
+            bool improveFrom(LocalSearchTour& tour, int a);
+            void reverseTourPath(LocalSearchTour& tour, int from, int to);
+            void moveTourSegment(LocalSearchTour& tour, int first, int length, int after, bool reversed);
     };
 
-    template <class T>
-    std::vector<std::string> WeightedTraversals<T>::validTraversalMethods(){
+    template <class T, class W>
+    WeightedTraversals<T, W>::WeightedTraversals()
+    : reachabilityIndex(nullptr)
+    { }
+
+    template <class T, class W>
+    std::vector<std::string> WeightedTraversals<T, W>::validTraversalMethods(){
         return {"DFS", "BFS", "UCS"}; 
     }
 
+    template <class T, class W>
+    void WeightedTraversals<T, W>::setReachabilityIndex(ReachabilityIndex<T, W>* index){
+        reachabilityIndex = index;
+    }
+
     /* 
         Linear time algorithm! 
         We can safely use this 
         function in path finding algorithms 
         without significant overhead cost.
+        (and with a reachability index attached it's a label lookup instead)
     */
-    template <class T>
-    bool WeightedTraversals<T>::doesPathExist(WeightedGraph<T> graph, Node<T>* start, Node<T>* end){
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::doesPathExist(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end){
+        if(reachabilityIndex != nullptr) return reachabilityIndex->reachable(start, end);
+
         std::set<Node<T>*> visited; 
         // std::queue<Node<T>*> nodesToVisit;
         NodeVisitor<T> nodesToVisit("BFS"); // Maybe pull this magic string out later.. but nevertheless BFS will be used. 
@@ -84,227 +341,861 @@ namespace Graphify{
         return false;
     }
 
-    template <class T>
-    std::tuple<int, std::vector<Node<T>*>> WeightedTraversals<T>::DAGShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end){
-        // before we create any variables or begin the search, let's make sure the path actually exists.
-        if(!doesPathExist(graph, start, end)) return { -1, {}};
+    // one pass over the topological order, see DAGPaths.. nodes on or behind a cycle come back unreachable
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::DAGShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end){
+        auto tree = DAGShortestPathTree(graph, start);
+        if(!tree.isReachable(end)) return {-1, {}};
+        return {tree.distanceTo(end), tree.pathTo(end)};
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::DAGLongestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end){
+        auto tree = DAGLongestPathTree(graph, start);
+        if(!tree.isReachable(end)) return {-1, {}};
+        return {tree.distanceTo(end), tree.pathTo(end)};
+    }
+
+    /*
+        Textbook Dijkstra, settling every node exactly once and stopping as soon as end is settled.
+        An unreachable end just empties the queue, so no separate doesPathExist pass is needed.
+
+        For integer weights there are two integer queues besides the comparison based indexed heap:
+        Dial's buckets when the largest weight is small (always, for 16 bit weights) and a radix heap
+        otherwise. "auto" picks between those two, and falls back to the heap for floating point
+        weights. Returns {-1, {}} when there is no path, like before. Negative weights would give
+        wrong distances without any sign of it, so they're reported and there's no path either
+        (bellmanFordShortestPath takes them).
+    */
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::djikstraShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end, std::string queueMethod){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return djikstraShortestPath(compressedGraph, start, end, queueMethod);
+    }
 
-        // the top sort function automatically detects if the graph is a DAG.
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::djikstraShortestPath(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, std::string queueMethod){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return djikstraShortestPath(weightedGraph, start, end, queueMethod); }
+        int source = graph.index(start);
+        int target = graph.index(end);
+        if(source == -1 || target == -1) return { -1, {}};
+        if(rejectNegativeWeights(graph)) return { -1, {}};
 
-        Traversals<T> traversals;
-        auto topSort = traversals.kahnTopSort(graph.unweightedGraph()); // our top sort to iterate over
+        std::vector<Distance> nodeDistance(graph.size(), WeightTraits<W>::unreachable());
+        std::vector<int> previousNode(graph.size(), -1);
+        dijkstra(graph, source, target, queueMethod, nodeDistance, previousNode);
 
-        Node<T>* currentNode = topSort.pop(); // guaranteed to not yield a segfault. 
-        NodeVisitor<T> nodesToVisit("BFS");
-        std::map<Node<T>*, int> nodeDistance; 
-        std::map<Node<T>*, Node<T>*> previousNode; 
-        previousNode[start] = nullptr; 
-        std::set<Node<T>*> visited;
+        if(nodeDistance[target] == WeightTraits<W>::unreachable()) return { -1, {}};
 
         std::vector<Node<T>*> path; 
+        for(int currentBackTrackedNode = target; currentBackTrackedNode != -1; currentBackTrackedNode = previousNode[currentBackTrackedNode]){
+            path.push_back(graph.nodes[currentBackTrackedNode]);
+        }
+        std::reverse(path.begin(), path.end());
+        return {nodeDistance[target], path};
+    }
 
-        nodeDistance.insert(std::make_pair(start, 0));
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::bidirectionalDjikstraShortestPath(WeightedGraph<T, W>& graph, Node<T>* start, Node<T>* end){
+        CompressedGraph<T, W> compressedGraph(graph);
+        CompressedGraph<T, W> reverseGraph = compressedGraph.transposed();
+        return bidirectionalDjikstraShortestPath(compressedGraph, reverseGraph, start, end);
+    }
 
-        while(currentNode != end){ 
-            if(visited.find(currentNode) != visited.end()) continue; 
-            for(auto neighbor : graph[currentNode]){
-                nodesToVisit.push(neighbor.first);
-                if(nodeDistance.find(neighbor.first) == nodeDistance.end()) {
-                     nodeDistance.insert(std::make_pair(neighbor.first, nodeDistance[currentNode] + neighbor.second));
-                     previousNode[neighbor.first] = currentNode;
-                }
-                else { 
-                    if(nodeDistance[currentNode] + neighbor.second <= nodeDistance[neighbor.first]){
-                        nodeDistance[neighbor.first] = nodeDistance[currentNode] + neighbor.second;
-                        previousNode[neighbor.first] = currentNode;
-                    }
+    /*
+        Bidirectional Dijkstra: a forward search from start over out edges and a backward search
+        from end over in edges (the transposed graph), always advancing the side whose next key is
+        smaller. Every edge scanned that reaches a node the other side has seen gives a candidate
+        path length, and once the two queue tops add up to at least the best candidate nothing left
+        can beat it. Two balls of radius d/2 are usually far smaller than one of radius d.
+    */
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::bidirectionalDjikstraShortestPath(CompressedGraph<T, W>& graph, CompressedGraph<T, W>& reverseGraph, Node<T>* start, Node<T>* end){
+        if(!graph.isWeighted() || !reverseGraph.isWeighted()){
+            CompressedGraph<T, W> weightedGraph = graph.isWeighted() ? graph : graph.unitWeighted();
+            CompressedGraph<T, W> weightedReverseGraph = reverseGraph.isWeighted() ? reverseGraph : reverseGraph.unitWeighted();
+            return bidirectionalDjikstraShortestPath(weightedGraph, weightedReverseGraph, start, end);
+        }
+        int source = graph.index(start);
+        int target = graph.index(end);
+        if(source == -1 || target == -1) return { -1, {}};
+        if(rejectNegativeWeights(graph)) return { -1, {}};
+        if(source == target) return {0, {start}};
+
+        int V = graph.size();
+        const Distance UNREACHED = WeightTraits<W>::unreachable();
+        std::vector<Distance> forwardDistance(V, UNREACHED), backwardDistance(V, UNREACHED);
+        std::vector<int> forwardPrevious(V, -1), backwardNext(V, -1); // backwardNext points one step closer to end
+        IndexedHeap<Distance> forwardNodesToVisit(V), backwardNodesToVisit(V);
+
+        forwardDistance[source] = 0;
+        backwardDistance[target] = 0;
+        forwardNodesToVisit.push(source, 0);
+        backwardNodesToVisit.push(target, 0);
+
+        Distance bestLength = UNREACHED;
+        int meetingNode = -1;
+
+        auto settleNext = [&](CompressedGraph<T, W>& searchGraph, IndexedHeap<Distance>& nodesToVisit, std::vector<Distance>& distance, std::vector<int>& previous, std::vector<Distance>& otherDistance){
+            int v = nodesToVisit.pop();
+            for(int e = searchGraph.offsets[v]; e < searchGraph.offsets[v+1]; e++){
+                int w = searchGraph.targets[e];
+                Distance newDistance = distance[v] + searchGraph.weights[e];
+                if(newDistance < distance[w]){
+                    distance[w] = newDistance;
+                    previous[w] = v;
+                    nodesToVisit.pushOrDecrease(w, newDistance);
+                }
+                // distance[w] <= the path through v, so checking w's own total covers this edge too
+                if(otherDistance[w] != UNREACHED && distance[w] + otherDistance[w] < bestLength){
+                    bestLength = distance[w] + otherDistance[w];
+                    meetingNode = w;
                 }
             }
-            currentNode = topSort.pop();
+        };
+
+        while(!forwardNodesToVisit.empty() && !backwardNodesToVisit.empty()){
+            if(forwardNodesToVisit.topKey() + backwardNodesToVisit.topKey() >= bestLength) break;
+
+            if(forwardNodesToVisit.topKey() <= backwardNodesToVisit.topKey()) settleNext(graph, forwardNodesToVisit, forwardDistance, forwardPrevious, backwardDistance);
+            else settleNext(reverseGraph, backwardNodesToVisit, backwardDistance, backwardNext, forwardDistance);
         }
 
-        path.push_back(end);
+        if(meetingNode == -1) return { -1, {}};
 
-        Node<T>* currentBackTrackedNode = previousNode[currentNode]; 
+        std::vector<Node<T>*> path;
+        for(int currentBackTrackedNode = meetingNode; currentBackTrackedNode != -1; currentBackTrackedNode = forwardPrevious[currentBackTrackedNode]){
+            path.push_back(graph.nodes[currentBackTrackedNode]);
+        }
+        std::reverse(path.begin(), path.end());
+        for(int currentNode = backwardNext[meetingNode]; currentNode != -1; currentNode = backwardNext[currentNode]){
+            path.push_back(graph.nodes[currentNode]);
+        }
+        return {bestLength, path};
+    }
 
-        while(currentBackTrackedNode != nullptr){
-            path.push_back(currentBackTrackedNode);
-            currentBackTrackedNode = previousNode[currentBackTrackedNode];
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::djikstraShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start, std::string queueMethod){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return djikstraShortestPathTree(compressedGraph, start, queueMethod);
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::djikstraShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, std::string queueMethod){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return djikstraShortestPathTree(weightedGraph, start, queueMethod); }
+        ShortestPathTree<T, Distance> tree(graph, graph.index(start));
+        if(tree.sourceIndex == -1) return tree;
+        if(rejectNegativeWeights(graph)) return tree; // only the source is in the tree
+
+        dijkstra(graph, tree.sourceIndex, -1, queueMethod, tree.nodeDistance, tree.previousNode); // no target, so it settles everything reachable
+        return tree;
+    }
+
+    template <class T, class W>
+    void WeightedTraversals<T, W>::dijkstra(CompressedGraph<T, W>& graph, int source, int target, std::string queueMethod, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode){
+        queueMethod = pickQueueMethod(graph, queueMethod);
+        if constexpr(std::is_integral<W>::value){ // the other queues only take integer keys
+            if(queueMethod == "buckets"){
+                BucketQueue nodesToVisit(int(graph.maxWeight()));
+                monotoneQueueDijkstra(graph, source, target, nodesToVisit, nodeDistance, previousNode);
+                return;
+            }
+            if(queueMethod == "radix"){
+                RadixHeap nodesToVisit;
+                monotoneQueueDijkstra(graph, source, target, nodesToVisit, nodeDistance, previousNode);
+                return;
+            }
         }
+        heapDijkstra(graph, source, target, nodeDistance, previousNode);
+    }
 
-        std::reverse(path.begin(), path.end());
-        return {nodeDistance[end], path};
+    template <class T, class W>
+    std::vector<std::string> WeightedTraversals<T, W>::validQueueMethods(){
+        return {"auto", "heap", "buckets", "radix"};
     }
 
-    // 3 lined function
-    template <class T>
-    std::tuple<int, std::vector<Node<T>*>> WeightedTraversals<T>::DAGLongestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end){
-        graph.scalarMultiply(-1);
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::rejectNegativeWeights(CompressedGraph<T, W>& graph){
+        ErrorHandling<T> handler;
+        handler.checkNonNegativeEdgeWeight(graph.minWeight());
+        return graph.minWeight() < 0;
+    }
 
-        // all err handling dealt with by dag shortest path functions and other function calls within it..
-        auto [length, path] = DAGShortestPath(graph, start, end);
+    template <class T, class W>
+    std::string WeightedTraversals<T, W>::pickQueueMethod(CompressedGraph<T, W>& graph, std::string queueMethod){
+        ErrorHandling<T> handler;
+        handler.checkUnknownShortestPathQueueMethod(queueMethod, validQueueMethods()); // reported, then treated like "auto"
+
+        if(!std::is_integral<W>::value) return "heap"; // the integer queues need integer keys
+        long long maxWeight = (long long)graph.maxWeight();
+        if(queueMethod == "heap" || queueMethod == "radix") return queueMethod;
+        if(queueMethod == "buckets" && maxWeight < MAX_BUCKET_QUEUE_BUCKETS) return queueMethod;
+        if(queueMethod == "auto" && (WeightTraits<W>::useBucketQueue || maxWeight <= MAX_BUCKET_QUEUE_WEIGHT)) return "buckets"; // 16 bit weights never need more than 65536 buckets
+        return "radix";
+    }
 
-        return {-length, path};
-    }   
+    // indexed heap with decrease-key, so each node is in the queue at most once
+    template <class T, class W>
+    template <class EdgeWeight, class D>
+    void WeightedTraversals<T, W>::heapDijkstra(CompressedGraph<T, EdgeWeight>& graph, int source, int target, std::vector<D>& nodeDistance, std::vector<int>& previousNode){
+        std::vector<char> settled(graph.size(), 0);
+        IndexedHeap<D> nodesToVisit(graph.size());
 
-    /* NOTE: This is a LAZY implementation (no Binary Heaps) 
-        neighbor.first = node obj, neighbor.second = integer weight
-    */ 
+        nodeDistance[source] = 0;
+        nodesToVisit.push(source, 0);
+
+        while(!nodesToVisit.empty()){
+            int currentNode = nodesToVisit.pop();
+            settled[currentNode] = 1;
+            if(currentNode == target) return; // end is settled, nothing later can improve it
+
+            for(int e = graph.offsets[currentNode]; e < graph.offsets[currentNode+1]; e++){
+                int neighbor = graph.targets[e];
+                if(settled[neighbor]) continue;
+
+                D newDistance = nodeDistance[currentNode] + graph.weights[e];
+                if(newDistance < nodeDistance[neighbor]){
+                    nodeDistance[neighbor] = newDistance;
+                    previousNode[neighbor] = currentNode;
+                    nodesToVisit.pushOrDecrease(neighbor, newDistance);
+                }
+            }
+        }
+    }
+
+    // lazy queues (BucketQueue, RadixHeap): improved nodes are pushed again and stale entries skipped on pop
+    template <class T, class W>
+    template <class Queue>
+    void WeightedTraversals<T, W>::monotoneQueueDijkstra(CompressedGraph<T, W>& graph, int source, int target, Queue& nodesToVisit, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode){
+        nodeDistance[source] = 0;
+        nodesToVisit.push(0, source);
+
+        while(!nodesToVisit.empty()){
+            auto [currentDistance, currentNode] = nodesToVisit.pop();
+            if(currentDistance != nodeDistance[currentNode]) continue; // stale entry..
+            if(currentNode == target) return;
+
+            for(int e = graph.offsets[currentNode]; e < graph.offsets[currentNode+1]; e++){
+                int neighbor = graph.targets[e];
+                Distance newDistance = nodeDistance[currentNode] + graph.weights[e];
+                if(newDistance < nodeDistance[neighbor]){
+                    nodeDistance[neighbor] = newDistance;
+                    previousNode[neighbor] = currentNode;
+                    nodesToVisit.push(newDistance, neighbor);
+                }
+            }
+        }
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::deltaSteppingShortestPaths(WeightedGraph<T, W>& graph, Node<T>* start, W delta, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return deltaSteppingShortestPaths(compressedGraph, start, delta, numThreads);
+    }
 
     /*
-        ->To do for Dijkstra: ensure that there actually exists a path => done
-        -> return a tuple containting the path itself, too  => done 
+        Delta-stepping (Meyer & Sanders). Tentative distances live in buckets of width delta, and
+        the lowest non-empty bucket is settled in phases: all of its nodes relax their light edges
+        (weight <= delta) in parallel, which may refill the same bucket, until it stays empty. Then
+        every node settled in that bucket relaxes its heavy edges once, again in parallel; those
+        can only land in later buckets. delta = 1 behaves like Dial's Dijkstra and delta = infinity
+        like Bellman-Ford, in between there is plenty of parallel work per phase without much
+        wasted relaxation.
+
+        A node's distance and parent are packed into one 64 bit word and lowered with a CAS, so a
+        relaxation updates both at once. Only strictly shorter distances are written (never parent
+        only tie breaks), which keeps zero weight cycles from turning into parent cycles. Distances
+        that don't fit the packed label (see PACKED_DISTANCES) get a serial Dijkstra instead.
     */
-    template <class T>
-    std::tuple<int, std::vector<Node<T>*>> WeightedTraversals<T>::djikstraShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end){
-        // before we create any variables or begin the search, let's make sure the path actually exists.
-        if(!doesPathExist(graph, start, end)) return { -1, {}}; 
-
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::deltaSteppingShortestPaths(CompressedGraph<T, W>& graph, Node<T>* start, W delta, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return deltaSteppingShortestPaths(weightedGraph, start, delta, numThreads); }
+        int V = graph.size();
+        int source = graph.index(start);
+        ShortestPathTree<T, Distance> tree(graph, source);
+        if(source == -1) return tree;
+
+        if(rejectNegativeWeights(graph)) return tree; // buckets can't go backwards.. only the source is in the tree
+
+        if constexpr(!PACKED_DISTANCES){
+            heapDijkstra(graph, source, -1, tree.nodeDistance, tree.previousNode);
+            return tree;
+        }
 
-        Node<T>* currentNode = start; 
-        NodeVisitor<T> nodesToVisit("BFS");
-        std::map<Node<T>*, int> nodeDistance; 
-        std::map<Node<T>*, Node<T>*> previousNode; 
-        previousNode[start] = nullptr; 
-        std::set<Node<T>*> visited;
+        if(delta <= 0) delta = defaultDelta(graph);
+        // the ring below has maxWeight / delta + 2 buckets, a tiny delta on big weights would allocate them by the billion
+        if((long long)(graph.maxWeight() / delta) > MAX_BUCKET_QUEUE_BUCKETS - 2){
+            delta = W(graph.maxWeight() / (MAX_BUCKET_QUEUE_BUCKETS - 2) + 1);
+        }
 
-        std::vector<Node<T>*> path; 
+        const unsigned long long UNREACHED = ULLONG_MAX; // distance part decodes to INT_MAX, above any packed distance
+        auto pack = packLabel;
+        auto distanceOf = labelDistance;
+        auto bucketOf = [&](long long nodeDistance){ return (long long)(nodeDistance / delta); };
+        std::atomic<bool> overflow(false);
+
+        std::vector<std::atomic<unsigned long long>> labels(V);
+        for(auto& label : labels) label.store(UNREACHED, std::memory_order_relaxed);
+        labels[source].store(pack(0, -1), std::memory_order_relaxed);
+
+        // keys in flight always lie within maxWeight of the current bucket, so a ring of buckets is enough
+        long long numBuckets = (long long)(graph.maxWeight() / delta) + 2;
+        std::vector<std::vector<int>> buckets(numBuckets);
+        buckets[0].push_back(source);
+        size_t pendingEntries = 1;
+
+        int maxThreads = resolveNumThreads(numThreads, V);
+        std::vector<std::vector<int>> improvedNodes(maxThreads); // per thread, merged into the buckets after each phase
+
+        auto relaxEdges = [&](std::vector<int>& nodes, bool light){
+            parallelFor(0, int(nodes.size()), [&](int k, int threadId){
+                int v = nodes[k];
+                long long nodeDistance = distanceOf(labels[v].load(std::memory_order_relaxed));
+
+                for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                    if((graph.weights[e] <= delta) != light) continue;
+
+                    int w = graph.targets[e];
+                    long long newDistance = nodeDistance + graph.weights[e];
+                    if(!fitsLabel(newDistance)){
+                        overflow.store(true, std::memory_order_relaxed);
+                        continue;
+                    }
 
-        nodeDistance.insert(std::make_pair(start, 0));
+                    unsigned long long candidate = pack(newDistance, v);
+                    unsigned long long current = labels[w].load(std::memory_order_relaxed);
+                    while(newDistance < distanceOf(current)){
+                        if(labels[w].compare_exchange_weak(current, candidate, std::memory_order_relaxed)){
+                            improvedNodes[threadId].push_back(w);
+                            break;
+                        }
+                    }
+                }
+            }, numThreads);
 
-        while(currentNode != end){ 
-            if(visited.find(currentNode) != visited.end()) continue; 
-            for(auto neighbor : graph[currentNode]){
-                nodesToVisit.push(neighbor.first);
-                if(nodeDistance.find(neighbor.first) == nodeDistance.end()) {
-                     nodeDistance.insert(std::make_pair(neighbor.first, nodeDistance[currentNode] + neighbor.second));
-                     previousNode[neighbor.first] = currentNode;
-                }
-                else { 
-                    if(nodeDistance[currentNode] + neighbor.second <= nodeDistance[neighbor.first]){
-                        nodeDistance[neighbor.first] = nodeDistance[currentNode] + neighbor.second;
-                        previousNode[neighbor.first] = currentNode;
+            for(auto& improved : improvedNodes){
+                for(auto w : improved) buckets[bucketOf(distanceOf(labels[w].load(std::memory_order_relaxed))) % numBuckets].push_back(w);
+                pendingEntries += improved.size();
+                improved.clear();
+            }
+        };
+
+        std::vector<long long> inFrontier(V, -1); // phase stamps, so duplicate bucket entries are only expanded once
+        std::vector<long long> settledIn(V, -1); // bucket stamps
+        std::vector<int> frontier, settled;
+        long long phase = 0;
+
+        for(long long i = 0; pendingEntries > 0 && !overflow.load(); i++){
+            auto& bucket = buckets[i % numBuckets];
+            if(bucket.empty()) continue;
+
+            settled.clear();
+            while(!bucket.empty()){
+                frontier.clear();
+                phase++;
+                for(auto v : bucket){
+                    if(bucketOf(distanceOf(labels[v].load(std::memory_order_relaxed))) != i) continue; // stale entry..
+                    if(inFrontier[v] == phase) continue;
+                    inFrontier[v] = phase;
+                    frontier.push_back(v);
+                    if(settledIn[v] != i){
+                        settledIn[v] = i;
+                        settled.push_back(v);
                     }
                 }
+                pendingEntries -= bucket.size();
+                bucket.clear();
+
+                relaxEdges(frontier, true);
             }
-            currentNode = nodesToVisit.pop();
+            relaxEdges(settled, false);
         }
 
-        path.push_back(end);
+        if(overflow.load()){ // some distance outgrew the packed label, Dijkstra keeps the whole Distance
+            heapDijkstra(graph, source, -1, tree.nodeDistance, tree.previousNode);
+            return tree;
+        }
+        for(int v = 0; v < V; v++){
+            unsigned long long label = labels[v].load(std::memory_order_relaxed);
+            if(label == UNREACHED) continue;
+            tree.nodeDistance[v] = distanceOf(label);
+            tree.previousNode[v] = int(label & 0xFFFFFFFFull);
+        }
+        return tree;
+    }
 
-        Node<T>* currentBackTrackedNode = previousNode[currentNode]; 
+    // Meyer & Sanders pick delta ~ maxWeight / degree, the average out-degree is less thrown off by hubs than the max
+    template <class T, class W>
+    W WeightedTraversals<T, W>::defaultDelta(CompressedGraph<T, W>& graph){
+        if(graph.size() == 0 || graph.numEdges() == 0) return 1;
+        double averageDegree = double(graph.numEdges()) / graph.size();
+        return std::max<W>(1, W(graph.maxWeight() / std::max(1.0, averageDegree)));
+    }
 
-        while(currentBackTrackedNode != nullptr){
-            path.push_back(currentBackTrackedNode);
-            currentBackTrackedNode = previousNode[currentBackTrackedNode];
+    template <class T, class W>
+    template <class H>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::alphaStarShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end, const std::map<Node<T>*, H>& h){
+        CompressedGraph<T, W> compressedGraph(graph);
+
+        std::vector<Distance> heuristicValue(compressedGraph.size(), 0);
+        for(auto [node, value] : h){
+            int i = compressedGraph.index(node);
+            if(i != -1) heuristicValue[i] = Distance(value);
         }
+        return alphaStarShortestPath(compressedGraph, start, end, [&heuristicValue](int node){ return heuristicValue[node]; });
+    }
+
+    /*
+        A*: Dijkstra ordered by distance so far + heuristic(node) instead of distance so far, so
+        the search leans toward end. With an admissible heuristic the first time end is popped its
+        distance is final. A node whose distance improves after it was popped (possible when the
+        heuristic isn't consistent) simply goes back into the queue. heuristic is called at most
+        once per node.
+    */
+    template <class T, class W>
+    template <class Heuristic>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::alphaStarShortestPath(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, Heuristic heuristic){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return alphaStarShortestPath(weightedGraph, start, end, heuristic); }
+        int source = graph.index(start);
+        int target = graph.index(end);
+        if(source == -1 || target == -1) return { -1, {}};
+
+        std::vector<Distance> nodeDistance(graph.size(), WeightTraits<W>::unreachable());
+        std::vector<int> previousNode(graph.size(), -1);
+        std::vector<Distance> heuristicValue(graph.size());
+        std::vector<char> computed(graph.size(), 0);
+        IndexedHeap<Distance> nodesToVisit(graph.size());
+
+        nodeDistance[source] = 0;
+        heuristicValue[source] = heuristic(source);
+        computed[source] = 1;
+        nodesToVisit.push(source, heuristicValue[source]);
 
+        while(!nodesToVisit.empty()){
+            int currentNode = nodesToVisit.pop();
+            if(currentNode == target) break;
+
+            for(int e = graph.offsets[currentNode]; e < graph.offsets[currentNode+1]; e++){
+                int neighbor = graph.targets[e];
+                Distance newDistance = nodeDistance[currentNode] + graph.weights[e];
+                if(newDistance >= nodeDistance[neighbor]) continue;
+
+                nodeDistance[neighbor] = newDistance;
+                previousNode[neighbor] = currentNode;
+                if(!computed[neighbor]){
+                    heuristicValue[neighbor] = heuristic(neighbor);
+                    computed[neighbor] = 1;
+                }
+                nodesToVisit.pushOrDecrease(neighbor, newDistance + heuristicValue[neighbor]);
+            }
+        }
+
+        if(nodeDistance[target] == WeightTraits<W>::unreachable()) return { -1, {}};
+
+        std::vector<Node<T>*> path;
+        for(int currentBackTrackedNode = target; currentBackTrackedNode != -1; currentBackTrackedNode = previousNode[currentBackTrackedNode]){
+            path.push_back(graph.nodes[currentBackTrackedNode]);
+        }
         std::reverse(path.begin(), path.end());
-        return {nodeDistance[end], path};
+        return {nodeDistance[target], path};
     }
 
-    template <class T>
-    std::tuple<int, std::vector<Node<T>*>> WeightedTraversals<T>::alphaStarShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end, std::map<Node<T>*, int> h){
-        // before we create any variables or begin the search, let's make sure the path actually exists.
-        if(!doesPathExist(graph, start, end)) return { -1, {}}; 
+    // SPFA underneath, so it stops as soon as the distances settle instead of always doing V - 1 passes.
+    // => {-1, {}} if end is unreachable or a negative cycle is reachable from start (no shortest path then).
+    // An unreachable end is simply never relaxed, so no separate doesPathExist pass is needed.
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::bellmanFordShortestPath(WeightedGraph<T, W> graph, Node<T>* start, Node<T>* end){
+        auto tree = spfaShortestPathTree(graph, start);
+        if(tree.negativeCycle || !tree.isReachable(end)) return { -1, {}};
 
+        return {tree.distanceTo(end), tree.pathTo(end)};
+    }
 
-        Node<T>* currentNode = start; 
-        NodeVisitor<T> nodesToVisit("BFS");
-        std::map<Node<T>*, int> nodeDistance; 
-        std::map<Node<T>*, Node<T>*> previousNode; 
-        previousNode[start] = nullptr; 
-        std::set<Node<T>*> visited;
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::bellmanFordShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return bellmanFordShortestPathTree(compressedGraph, start);
+    }
 
-        std::vector<Node<T>*> path; 
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::bellmanFordShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return bellmanFordShortestPathTree(weightedGraph, start); }
+        ShortestPathTree<T, Distance> tree(graph, graph.index(start));
+        if(tree.sourceIndex == -1) return tree;
 
-        nodeDistance.insert(std::make_pair(start, 0));
+        tree.negativeCycle = !bellmanFord(graph, tree.nodeDistance, tree.previousNode);
+        return tree;
+    }
 
-        while(currentNode != end){ 
-            if(visited.find(currentNode) != visited.end()) continue; 
-            for(auto neighbor : graph[currentNode]){
-                nodesToVisit.push(neighbor.first);
-                if(nodeDistance.find(neighbor.first) == nodeDistance.end()) {
-                     nodeDistance.insert(std::make_pair(neighbor.first, nodeDistance[currentNode] + neighbor.second + h[neighbor.first]));
-                     previousNode[neighbor.first] = currentNode;
-                }
-                else { 
-                    if(h[currentNode] + nodeDistance[currentNode] + neighbor.second <= nodeDistance[neighbor.first] + h[neighbor.first]){
-                        nodeDistance[neighbor.first] = nodeDistance[currentNode] + neighbor.second;
-                        previousNode[neighbor.first] = currentNode;
+    // Relaxes every edge until nothing changes, starting from whatever distances are already set (the largest Distance = not reached).
+    // => false if there's still a change after V rounds, i.e. a negative cycle is reachable.
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::bellmanFord(CompressedGraph<T, W>& graph, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode){
+        for(int round = 0; round < graph.size(); round++){
+            bool changed = false;
+            for(int v = 0; v < graph.size(); v++){
+                if(nodeDistance[v] == WeightTraits<W>::unreachable()) continue;
+                for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                    int w = graph.targets[e];
+                    Distance newDistance = nodeDistance[v] + graph.weights[e];
+                    if(newDistance < nodeDistance[w]){
+                        nodeDistance[w] = newDistance;
+                        previousNode[w] = v;
+                        changed = true;
                     }
                 }
             }
-            currentNode = nodesToVisit.pop();
+            if(!changed) return true; // usually long before V rounds
         }
+        return false;
+    }
 
-        path.push_back(end);
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::spfaShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return spfaShortestPathTree(compressedGraph, start);
+    }
 
-        Node<T>* currentBackTrackedNode = previousNode[currentNode]; 
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::spfaShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return spfaShortestPathTree(weightedGraph, start); }
+        ShortestPathTree<T, Distance> tree(graph, graph.index(start));
+        if(tree.sourceIndex == -1) return tree;
 
-        while(currentBackTrackedNode != nullptr){
-            path.push_back(currentBackTrackedNode);
-            currentBackTrackedNode = previousNode[currentBackTrackedNode];
+        tree.negativeCycle = !spfa(graph, tree.nodeDistance, tree.previousNode);
+        return tree;
+    }
+
+    /*
+        SPFA: a FIFO of nodes whose distance changed, each rescanned once per change instead of every
+        edge every round. Worst case is still O(VE) but most graphs settle in a few passes. Every node
+        tracks how many edges its current path has; a path of V edges must repeat a node, and since
+        it kept getting shorter that repeated stretch is a negative cycle. Starts from every node that
+        already has a distance. => false on a negative cycle.
+    */
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::spfa(CompressedGraph<T, W>& graph, std::vector<Distance>& nodeDistance, std::vector<int>& previousNode){
+        int V = graph.size();
+        std::vector<int> pathEdges(V, 0);
+        std::vector<char> inQueue(V, 0);
+        std::queue<int> nodesToVisit;
+
+        for(int v = 0; v < V; v++){
+            if(nodeDistance[v] == WeightTraits<W>::unreachable()) continue;
+            nodesToVisit.push(v);
+            inQueue[v] = 1;
         }
 
-        std::reverse(path.begin(), path.end());
-        return {nodeDistance[end], path};
+        while(!nodesToVisit.empty()){
+            int v = nodesToVisit.front();
+            nodesToVisit.pop();
+            inQueue[v] = 0;
+
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                int w = graph.targets[e];
+                Distance newDistance = nodeDistance[v] + graph.weights[e];
+                if(newDistance >= nodeDistance[w]) continue;
+
+                nodeDistance[w] = newDistance;
+                previousNode[w] = v;
+                pathEdges[w] = pathEdges[v] + 1;
+                if(pathEdges[w] >= V) return false;
+
+                if(!inQueue[w]){
+                    nodesToVisit.push(w);
+                    inQueue[w] = 1;
+                }
+            }
+        }
+        return true;
     }
 
-    template <class T>
-    std::tuple<int, std::vector<Node<T>*>> WeightedTraversals<T>::bellmanFordShortestPath(WeightedGraph<T> graph, Node<T>* start, Node<T>* end){
-        if(!doesPathExist(graph, start, end)) return { -1, {}}; // probably will want to change this to inf or int_max..
-        auto edges = graph.weightedEdgeList();
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::parallelBellmanFordShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return parallelBellmanFordShortestPathTree(compressedGraph, start, numThreads);
+    }
 
-        std::map<Node<T>*, int> nodeDistance; 
-        nodeDistance.insert(std::make_pair(start, 0));
+    /*
+        Edge parallel Bellman-Ford. The edges are one flat structure of arrays (sources next to the
+        CSR's targets and weights), so a round is a straight parallel sweep over three arrays. An edge
+        is only relaxed if its source improved in the previous round, which is SPFA's idea without a
+        shared queue, and the rounds stop as soon as one changes nothing.
+
+        Distance and parent share one atomic 64 bit word, as in delta-stepping. The distance goes in
+        the high half with its sign bit flipped, so negative distances still order correctly. If one
+        doesn't fit there (see PACKED_DISTANCES) the search is handed to the serial SPFA instead.
+    */
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::parallelBellmanFordShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return parallelBellmanFordShortestPathTree(weightedGraph, start, numThreads); }
+        int V = graph.size();
+        int source = graph.index(start);
+        ShortestPathTree<T, Distance> tree(graph, source);
+        if(source == -1) return tree;
+
+        if constexpr(!PACKED_DISTANCES){
+            tree.negativeCycle = !spfa(graph, tree.nodeDistance, tree.previousNode);
+            return tree;
+        }
 
-        const int NUM_ITERATIONS = graph.size() - 1;
+        std::vector<int> edgeSources(graph.numEdges());
+        for(int v = 0; v < V; v++){
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++) edgeSources[e] = v;
+        }
 
-        std::map<Node<T>*, Node<T>*> previousNode; 
-        previousNode[start] = nullptr; 
+        const unsigned long long UNREACHED = ULLONG_MAX; // distance part decodes to INT_MAX
+        auto pack = packLabel;
+        auto distanceOf = labelDistance;
+        std::atomic<bool> overflow(false);
 
-        std::vector<Node<T>*> path;
+        std::vector<std::atomic<unsigned long long>> labels(V);
+        std::vector<std::atomic<int>> lastImproved(V); // round in which the node's distance last went down
+        for(int v = 0; v < V; v++){
+            labels[v].store(UNREACHED, std::memory_order_relaxed);
+            lastImproved[v].store(-2, std::memory_order_relaxed);
+        }
+        labels[source].store(pack(0, -1), std::memory_order_relaxed);
+        lastImproved[source].store(-1, std::memory_order_relaxed);
+
+        int round = 0;
+        for(; round < V && !overflow.load(); round++){
+            std::atomic<bool> changed(false);
 
+            parallelFor(0, graph.numEdges(), [&](int e){
+                int v = edgeSources[e];
+                if(lastImproved[v].load(std::memory_order_relaxed) < round - 1) return; // nothing new to pass on
 
-        for(int i = 0; i < NUM_ITERATIONS; i++){
-            for(auto edge : edges){
-                if(nodeDistance.find(std::get<0>(edge)) == nodeDistance.end() && nodeDistance.find(std::get<1>(edge)) == nodeDistance.end()){
-                    continue; 
-                } 
-                else if(nodeDistance.find(std::get<0>(edge)) != nodeDistance.end() && nodeDistance.find(std::get<1>(edge)) == nodeDistance.end()){
-                    nodeDistance[std::get<1>(edge)] = nodeDistance[std::get<0>(edge)] + std::get<2>(edge);
-                    previousNode[std::get<1>(edge)] = std::get<0>(edge);
+                long long newDistance = distanceOf(labels[v].load(std::memory_order_relaxed)) + graph.weights[e];
+                if(!fitsLabel(newDistance)){
+                    overflow.store(true, std::memory_order_relaxed);
+                    return;
                 }
-                else if(nodeDistance.find(std::get<0>(edge)) != nodeDistance.end() && nodeDistance.find(std::get<1>(edge)) != nodeDistance.end()){
-                    if(nodeDistance[std::get<0>(edge)] + std::get<2>(edge) < nodeDistance[std::get<1>(edge)]){
-                        nodeDistance[std::get<1>(edge)] = nodeDistance[std::get<0>(edge)] + std::get<2>(edge);
-                        previousNode[std::get<1>(edge)] = std::get<0>(edge);
+
+                int w = graph.targets[e];
+                unsigned long long candidate = pack(newDistance, v);
+                unsigned long long current = labels[w].load(std::memory_order_relaxed);
+                while(newDistance < distanceOf(current)){
+                    if(labels[w].compare_exchange_weak(current, candidate, std::memory_order_relaxed)){
+                        lastImproved[w].store(round, std::memory_order_relaxed);
+                        changed.store(true, std::memory_order_relaxed);
+                        break;
                     }
                 }
-            }
+            }, numThreads, 4096);
+
+            if(!changed.load()) break;
+        }
+        if(overflow.load()){ // some distance outgrew the packed label (a negative cycle does that too, given time)
+            tree.negativeCycle = !spfa(graph, tree.nodeDistance, tree.previousNode);
+            return tree;
         }
-        path.push_back(end);
+        tree.negativeCycle = round == V; // still improving after V rounds
 
-        Node<T>* currentBackTrackedNode = previousNode[end]; 
+        for(int v = 0; v < V; v++){
+            unsigned long long label = labels[v].load(std::memory_order_relaxed);
+            if(label == UNREACHED) continue;
+            tree.nodeDistance[v] = distanceOf(label);
+            tree.previousNode[v] = int(label & 0xFFFFFFFFull);
+        }
+        return tree;
+    }
 
-        while(currentBackTrackedNode != nullptr){
-            path.push_back(currentBackTrackedNode);
-            currentBackTrackedNode = previousNode[currentBackTrackedNode];
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGShortestPathTree(WeightedGraph<T, W>& graph, Node<T>* start){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return DAGShortestPathTree(compressedGraph, start);
+    }
+
+    // Kahn's order on the CSR, then every edge is relaxed exactly once. Handles negative weights.
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start){
+        return DAGShortestPathTree(graph, start, {}, 1);
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGLongestPathTree(WeightedGraph<T, W>& graph, Node<T>* start){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return DAGLongestPathTree(compressedGraph, start);
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGLongestPathTree(CompressedGraph<T, W>& graph, Node<T>* start){
+        return DAGLongestPathTree(graph, start, {}, 1);
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGShortestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, const std::vector<W>& nodeWeights, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return DAGShortestPathTree(weightedGraph, start, nodeWeights, numThreads); }
+        ShortestPathTree<T, Distance> tree(graph, graph.index(start));
+        if(tree.sourceIndex != -1) DAGPaths(graph, tree.sourceIndex, nodeWeights, false, numThreads, tree);
+        return tree;
+    }
+
+    template <class T, class W>
+    ShortestPathTree<T, typename WeightTraits<W>::Distance> WeightedTraversals<T, W>::DAGLongestPathTree(CompressedGraph<T, W>& graph, Node<T>* start, const std::vector<W>& nodeWeights, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return DAGLongestPathTree(weightedGraph, start, nodeWeights, numThreads); }
+        ShortestPathTree<T, Distance> tree(graph, graph.index(start));
+        if(tree.sourceIndex != -1) DAGPaths(graph, tree.sourceIndex, nodeWeights, true, numThreads, tree);
+        return tree;
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::criticalPath(CompressedGraph<T, W>& graph, const std::vector<W>& nodeWeights, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return criticalPath(weightedGraph, nodeWeights, numThreads); }
+        ShortestPathTree<T, Distance> tree(graph, -1);
+        if(graph.size() == 0 || !DAGPaths(graph, -1, nodeWeights, true, numThreads, tree)) return {-1, {}};
+
+        int last = 0;
+        for(int v = 1; v < graph.size(); v++){
+            if(tree.nodeDistance[v] > tree.nodeDistance[last]) last = v;
         }
+        std::vector<Node<T>*> path;
+        for(auto v : tree.pathTo(last)) path.push_back(graph.nodes[v]); // by index, a by-node lookup would build the tree's node map
+        return {tree.nodeDistance[last], path};
+    }
 
-        std::reverse(path.begin(), path.end());
+    /*
+        Relaxes every edge exactly once, in Kahn's topological order, over flat arrays. Longest paths
+        are the same thing with the comparison flipped, which a DAG allows since it has no positive
+        cycles to run around.
+
+        With one thread it's the plain Kahn loop. Otherwise Kahn goes a level at a time- the nodes
+        whose in-degree hit 0 during the previous level- and a level's nodes are spread over threads.
+        Every node of a level already has its final distance, its out-edges lower (or raise) their
+        targets' packed {distance, parent} labels with a CAS, and whoever drops a target's in-degree
+        to 0 hands it to the next level. A distance that doesn't fit the label (see PACKED_DISTANCES)
+        sends the whole thing back to the plain loop.
+    */
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::DAGPaths(CompressedGraph<T, W>& graph, int source, const std::vector<W>& nodeWeights, bool longest, int numThreads, ShortestPathTree<T, Distance>& tree){
+        int V = graph.size();
+        const Distance UNREACHED_DISTANCE = WeightTraits<W>::unreachable();
+        auto nodeWeight = [&](int v){ return nodeWeights.empty() ? W(0) : nodeWeights[v]; };
+        auto better = [&](Distance candidate, Distance current){ return current == UNREACHED_DISTANCE || (longest ? candidate > current : candidate < current); };
+
+        auto kahnPaths = [&](){
+            std::vector<int> inDegree(V, 0);
+            for(auto w : graph.targets) inDegree[w]++;
+
+            std::vector<int> topSort;
+            topSort.reserve(V);
+            for(int v = 0; v < V; v++){
+                if(inDegree[v] != 0) continue;
+                topSort.push_back(v);
+                if(source == -1) tree.nodeDistance[v] = nodeWeight(v);
+            }
+            if(source != -1) tree.nodeDistance[source] = nodeWeight(source);
+
+            for(size_t head = 0; head < topSort.size(); head++){ // topSort doubles as Kahn's queue
+                int v = topSort[head];
+                for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                    int w = graph.targets[e];
+                    if(tree.nodeDistance[v] != UNREACHED_DISTANCE){
+                        Distance candidate = tree.nodeDistance[v] + graph.weights[e] + nodeWeight(w);
+                        if(better(candidate, tree.nodeDistance[w])){
+                            tree.nodeDistance[w] = candidate;
+                            tree.previousNode[w] = v;
+                        }
+                    }
+                    if(--inDegree[w] == 0) topSort.push_back(w);
+                }
+            }
 
-        return {nodeDistance[end], path};
+            // nodes on (or behind) a cycle never come out of Kahn's queue, so they don't get a distance
+            if(int(topSort.size()) == V) return true;
+            std::vector<char> ordered(V, 0);
+            for(auto v : topSort) ordered[v] = 1;
+            for(int v = 0; v < V; v++){
+                if(ordered[v]) continue;
+                tree.nodeDistance[v] = UNREACHED_DISTANCE;
+                tree.previousNode[v] = -1;
+            }
+            return false;
+        };
+
+        int threads = resolveNumThreads(numThreads, V);
+        if(threads == 1 || !PACKED_DISTANCES) return kahnPaths();
+
+        // longest paths store their distances negated, so a smaller packed label is a better one either way
+        const unsigned long long UNREACHED = ~0ULL;
+        auto pack = [&](long long distance, int parent){ return packLabel(longest ? -distance : distance, parent); };
+        auto distanceOf = [&](unsigned long long label){ return longest ? -labelDistance(label) : labelDistance(label); };
+        std::atomic<bool> overflow(false);
+
+        std::vector<std::atomic<int>> inDegree(V);
+        std::vector<std::atomic<unsigned long long>> labels(V);
+        parallelFor(0, V, [&](int v){
+            inDegree[v].store(0, std::memory_order_relaxed);
+            labels[v].store(UNREACHED, std::memory_order_relaxed);
+        }, threads);
+        parallelFor(0, V, [&](int v){
+            for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++) inDegree[graph.targets[e]].fetch_add(1, std::memory_order_relaxed);
+        }, threads);
+
+        std::vector<int> level;
+        for(int v = 0; v < V; v++){
+            if(inDegree[v].load(std::memory_order_relaxed) != 0) continue;
+            level.push_back(v);
+            if(source == -1) labels[v].store(pack(nodeWeight(v), -1), std::memory_order_relaxed);
+        }
+        if(source != -1) labels[source].store(pack(nodeWeight(source), -1), std::memory_order_relaxed);
+
+        int numOrdered = 0;
+        std::vector<std::vector<int>> nextLevel(threads);
+        while(!level.empty()){
+            numOrdered += int(level.size());
+
+            parallelFor(0, int(level.size()), [&](int i, int threadId){
+                int v = level[i];
+                unsigned long long label = labels[v].load(std::memory_order_relaxed);
+                long long distance = distanceOf(label);
+
+                for(int e = graph.offsets[v]; e < graph.offsets[v+1]; e++){
+                    int w = graph.targets[e];
+                    if(label != UNREACHED){
+                        long long candidate = distance + graph.weights[e] + nodeWeight(w);
+                        if(fitsLabel(candidate)){
+                            unsigned long long key = pack(candidate, v);
+                            unsigned long long current = labels[w].load(std::memory_order_relaxed);
+                            while(key < current && !labels[w].compare_exchange_weak(current, key, std::memory_order_relaxed)){ }
+                        }
+                        else overflow.store(true, std::memory_order_relaxed);
+                    }
+                    if(inDegree[w].fetch_sub(1, std::memory_order_relaxed) == 1) nextLevel[threadId].push_back(w);
+                }
+            }, threads);
+
+            level.clear();
+            for(auto& next : nextLevel){
+                level.insert(level.end(), next.begin(), next.end());
+                next.clear();
+            }
+        }
+
+        if(overflow.load()) return kahnPaths(); // the labels were cut short somewhere, the tree hasn't been touched yet
+
+        // a node whose in-degree never hit 0 is on or behind a cycle, so it doesn't get a distance either
+        parallelFor(0, V, [&](int v){
+            unsigned long long label = labels[v].load(std::memory_order_relaxed);
+            if(label == UNREACHED || inDegree[v].load(std::memory_order_relaxed) != 0){
+                tree.nodeDistance[v] = UNREACHED_DISTANCE;
+                tree.previousNode[v] = -1;
+                return;
+            }
+            tree.nodeDistance[v] = distanceOf(label);
+            tree.previousNode[v] = int(label & 0xffffffffu);
+        }, threads);
+        return numOrdered == V;
     }
 
     // this is an all pairs algorithm.. and the loop is iterative.. 
     // due to the nature of the algorithm checking if "path from a->b exists" is not necessary
 
     // O((|V|)^3)! 
-    template <class T>
-    std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, int>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> WeightedTraversals<T>::floydWarshall(WeightedGraph<T> graph){
-        std::map<std::pair<Node<T>*, Node<T>*>, int> distMat;
+    template <class T, class W>
+    std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, typename WeightTraits<W>::Distance>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> WeightedTraversals<T, W>::floydWarshall(WeightedGraph<T, W> graph){
+        std::map<std::pair<Node<T>*, Node<T>*>, Distance> distMat;
         std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>> paths;
 
         std::map<std::pair<Node<T>*, Node<T>*>, Node<T>*> previousNodes; 
@@ -359,169 +1250,1118 @@ namespace Graphify{
         return {distMat, paths};
     }
 
-    template <class T> 
-    std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, int>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> WeightedTraversals<T>::johnson(WeightedGraph<T> graph){
-        auto bfGraph = graph; 
-        Node<T>* bfNode = new Node<T>(); 
-        
-        for(auto [node, nodeAdjList] : bfGraph){
-            bfGraph.addEdge(bfNode, {node, 0}); // 0 weighted edge.
+    template <class T, class W>
+    std::vector<std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>>> WeightedTraversals<T, W>::kShortestPaths(WeightedGraph<T, W>& graph, Node<T>* start, Node<T>* end, int k, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return kShortestPaths(compressedGraph, start, end, k, numThreads);
+    }
+
+    /*
+        Yen: the i-th path is the best of the candidates spurred off the paths found before it.
+        A candidate keeps the first j + 1 nodes of a found path (the root), then runs Dijkstra from
+        node j to end with the root's other nodes removed, and with the next edge of every found path
+        that shares that root removed too, so the spur can't retrace a path already found.
+
+        Each path only gets spurred from the index where it left its own parent onwards (Lawler),
+        the earlier spurs would just find the parent's candidates again. The spurs of one path are
+        independent, so they're spread over threads, each with its own SpurWorkspace.
+    */
+    template <class T, class W>
+    std::vector<std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>>> WeightedTraversals<T, W>::kShortestPaths(CompressedGraph<T, W>& graph, Node<T>* start, Node<T>* end, int k, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return kShortestPaths(weightedGraph, start, end, k, numThreads); }
+        std::vector<std::tuple<Distance, std::vector<Node<T>*>>> paths;
+        int source = graph.index(start);
+        int target = graph.index(end);
+        if(source == -1 || target == -1 || k <= 0) return paths;
+        if(rejectNegativeWeights(graph)) return paths;
+
+        int V = graph.size();
+        int threads = resolveNumThreads(numThreads, V);
+        std::vector<SpurWorkspace> workspaces(threads);
+        for(auto& workspace : workspaces){
+            workspace.seen.assign(V, 0);
+            workspace.nodeDistance.assign(V, WeightTraits<W>::unreachable());
+            workspace.previousNode.assign(V, -1);
+            workspace.blockedNode.assign(V, 0);
+            workspace.blockedEdge.assign(graph.targets.size(), 0);
+            workspace.nodesToVisit.resize(V);
+        }
+
+        std::vector<RankedPath> found;
+        RankedPath shortest;
+        workspaces[0].search++;
+        if(!spurDijkstra(graph, source, target, workspaces[0], shortest)) return paths;
+        shortest.deviation = 0;
+        found.push_back(shortest);
+
+        std::priority_queue<RankedPath, std::vector<RankedPath>, std::greater<RankedPath>> candidates;
+        std::set<std::vector<int>> known = {shortest.nodes};
+
+        while(int(found.size()) < k){
+            const RankedPath& parent = found.back();
+            int numSpurs = int(parent.nodes.size()) - 1;
+            std::vector<RankedPath> spurs(numSpurs);
+
+            parallelFor(parent.deviation, numSpurs, [&](int j, int threadId){
+                SpurWorkspace& workspace = workspaces[threadId];
+                int spurNode = parent.nodes[j];
+                workspace.search++;
+
+                for(int i = 0; i < j; i++) workspace.blockedNode[parent.nodes[i]] = workspace.search;
+                for(auto& path : found){
+                    if(int(path.nodes.size()) <= j + 1 || !std::equal(path.nodes.begin(), path.nodes.begin() + j + 1, parent.nodes.begin())) continue;
+                    for(int e = graph.offsets[spurNode]; e < graph.offsets[spurNode+1]; e++){
+                        if(graph.targets[e] == path.nodes[j+1]) workspace.blockedEdge[e] = workspace.search;
+                    }
+                }
+
+                RankedPath spur;
+                if(!spurDijkstra(graph, spurNode, target, workspace, spur)){
+                    spurs[j].length = -1;
+                    return;
+                }
+
+                RankedPath& candidate = spurs[j];
+                candidate.nodes.assign(parent.nodes.begin(), parent.nodes.begin() + j);
+                candidate.prefixLength.assign(parent.prefixLength.begin(), parent.prefixLength.begin() + j);
+                for(size_t i = 0; i < spur.nodes.size(); i++){
+                    candidate.nodes.push_back(spur.nodes[i]);
+                    candidate.prefixLength.push_back(parent.prefixLength[j] + spur.prefixLength[i]);
+                }
+                candidate.length = candidate.prefixLength.back();
+                candidate.deviation = j;
+            }, threads, 1);
+
+            for(int j = parent.deviation; j < numSpurs; j++){
+                if(spurs[j].length != -1 && known.insert(spurs[j].nodes).second) candidates.push(spurs[j]);
+            }
+            if(candidates.empty()) break;
+
+            found.push_back(candidates.top());
+            candidates.pop();
+        }
+
+        for(auto& path : found){
+            std::vector<Node<T>*> pathNodes;
+            for(auto v : path.nodes) pathNodes.push_back(graph.nodes[v]);
+            paths.push_back({path.length, pathNodes});
+        }
+        return paths;
+    }
+
+    // heapDijkstra that skips what the workspace has blocked for its current search => false if target can't be reached
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::spurDijkstra(CompressedGraph<T, W>& graph, int source, int target, SpurWorkspace& workspace, RankedPath& spur){
+        int search = workspace.search;
+        auto distanceOf = [&](int v){ return workspace.seen[v] == search ? workspace.nodeDistance[v] : WeightTraits<W>::unreachable(); };
+
+        workspace.nodesToVisit.clear();
+        workspace.seen[source] = search;
+        workspace.nodeDistance[source] = 0;
+        workspace.previousNode[source] = -1;
+        workspace.nodesToVisit.push(source, 0);
+
+        bool reached = false;
+        while(!workspace.nodesToVisit.empty()){
+            int currentNode = workspace.nodesToVisit.pop();
+            if(currentNode == target){
+                reached = true;
+                break;
+            }
+
+            for(int e = graph.offsets[currentNode]; e < graph.offsets[currentNode+1]; e++){
+                int neighbor = graph.targets[e];
+                if(workspace.blockedEdge[e] == search || workspace.blockedNode[neighbor] == search) continue;
+
+                Distance newDistance = workspace.nodeDistance[currentNode] + graph.weights[e];
+                if(newDistance < distanceOf(neighbor)){
+                    workspace.seen[neighbor] = search;
+                    workspace.nodeDistance[neighbor] = newDistance;
+                    workspace.previousNode[neighbor] = currentNode;
+                    workspace.nodesToVisit.pushOrDecrease(neighbor, newDistance);
+                }
+            }
+        }
+        if(!reached) return false;
+
+        spur.nodes.clear();
+        spur.prefixLength.clear();
+        for(int currentBackTrackedNode = target; currentBackTrackedNode != -1; currentBackTrackedNode = workspace.previousNode[currentBackTrackedNode]){
+            spur.nodes.push_back(currentBackTrackedNode);
+            spur.prefixLength.push_back(workspace.nodeDistance[currentBackTrackedNode]);
         }
+        std::reverse(spur.nodes.begin(), spur.nodes.end());
+        std::reverse(spur.prefixLength.begin(), spur.prefixLength.end());
+        spur.length = spur.prefixLength.back();
+        return true;
+    }
 
+    /*
+        Blocked Floyd-Warshall (Venkataraman et al.). The matrix is padded to whole tiles and for
+        every pivot tile K:
 
-        std::map<Node<T>*, int> newWeightMap; 
+            1. the diagonal tile (K, K) relaxes through its own pivots
+            2. every other tile in row K and column K only needs the finished (K, K) tile, so they all run in parallel
+            3. every remaining tile (I, J) only needs (I, K) and (K, J), so those all run in parallel too
 
-        // finding dists from every node to the new bfNode as per the algorithn
-        for(auto [node, nodeAdjList] : bfGraph){
-            if(node == bfNode) continue;
-            auto [length, path] = bellmanFordShortestPath(bfGraph, bfNode, node);
-            newWeightMap[node] = length;
+        Each tile update is a min-plus product swept over contiguous rows, which is what the
+        SIMD kernel in minPlusBlock does. nextHop[i][j] is the node right after i on the best
+        path to j, so paths are read front to back without reversing anything.
+    */
+    template <class T, class W>
+    std::tuple<WeightedAdjacencyMatrix<T, typename WeightTraits<W>::Distance>, WeightedAdjacencyMatrix<T>> WeightedTraversals<T, W>::floydWarshallMatrix(WeightedAdjacencyMatrix<T, W>& adjMat, W noEdge, int numThreads){
+        const int B = FLOYD_WARSHALL_BLOCK;
+
+        int V = adjMat.size();
+        int numBlocks = (V + B - 1) / B;
+        int N = numBlocks * B; // padded rows are all INF, so they never relax anything
+
+        const W* weights = adjMat.data();
+        auto isEdge = [&](W weight){ return weight != noEdge && weight < std::numeric_limits<W>::max(); };
+
+        // a shortest path has fewer than V edges, so if V of the heaviest one stay below the int INF the int kernel is exact
+        bool intDistances = std::is_integral<W>::value;
+        long double heaviest = 0;
+        for(size_t i = 0; i < (size_t)V * V && intDistances; i++){
+            if(isEdge(weights[i])) heaviest = std::max(heaviest, (long double)(weights[i] < 0 ? -(long double)weights[i] : weights[i]));
         }
+        intDistances = intDistances && heaviest * V < floydWarshallInfinity<int>();
+
+        WeightedAdjacencyMatrix<T, Distance> distances(V, WeightTraits<W>::unreachable());
+        WeightedAdjacencyMatrix<T> nextHops(V, -1);
+        std::vector<int> nextHop((size_t)N * N, -1);
+
+        auto solve = [&](auto INF){
+            using D = decltype(INF);
+            std::vector<D> distance((size_t)N * N, INF);
+            parallelFor(0, V, [&](int i){
+                for(int j = 0; j < V; j++){
+                    W weight = weights[(size_t)i * V + j];
+                    if(!isEdge(weight)) continue;
+                    distance[(size_t)i * N + j] = D(weight);
+                    nextHop[(size_t)i * N + j] = j;
+                }
+                if(distance[(size_t)i * N + i] >= 0){ // a negative self loop is already a negative cycle
+                    distance[(size_t)i * N + i] = 0;
+                    nextHop[(size_t)i * N + i] = i;
+                }
+            }, numThreads);
+
+            if(blockedFloydWarshall(distance, nextHop, N, numThreads)) return false;
+
+            parallelFor(0, V, [&](int i){
+                for(int j = 0; j < V; j++){
+                    D d = distance[(size_t)i * N + j];
+                    if(d >= INF) continue;
+                    distances.data()[(size_t)i * V + j] = d;
+                    nextHops.data()[(size_t)i * V + j] = nextHop[(size_t)i * N + j];
+                }
+            }, numThreads);
+            return true;
+        };
+        bool noNegativeCycle = intDistances ? solve(floydWarshallInfinity<int>()) : solve(floydWarshallInfinity<Distance>());
+
+        ErrorHandling<T> handler;
+        handler.checkNoNegativeCycle(!noNegativeCycle);
+        if(!noNegativeCycle) return {WeightedAdjacencyMatrix<T, Distance>(0), WeightedAdjacencyMatrix<T>(0)};
+        return {distances, nextHops};
+    }
 
-        // weight updation
-        // W_uv_new = W_uv_old + bfWeight_u - bfWeight_v, for all edges (u, v)
-        for(auto [node, nodeAdjList] : bfGraph){
-            for(auto [baseNode, nodeAdjList] : bfGraph){
-                int oldWeight = bfGraph.getWeight(node, baseNode);
-                int newWeight = oldWeight + newWeightMap[node] - newWeightMap[baseNode];
-                bfGraph.setWeight(node, baseNode, newWeight);
+    // => true if a negative cycle showed up (and the distances were left as they were then)
+    template <class T, class W>
+    template <class D>
+    bool WeightedTraversals<T, W>::blockedFloydWarshall(std::vector<D>& distance, std::vector<int>& nextHop, int N, int numThreads){
+        int numBlocks = N / FLOYD_WARSHALL_BLOCK;
+
+        for(int K = 0; K < numBlocks; K++){
+            minPlusBlock(distance.data(), nextHop.data(), N, K, K, K);
+
+            parallelFor(0, 2 * numBlocks, [&](int b){
+                int other = b / 2;
+                if(other == K) return;
+                if(b % 2 == 0) minPlusBlock(distance.data(), nextHop.data(), N, K, other, K);
+                else minPlusBlock(distance.data(), nextHop.data(), N, other, K, K);
+            }, numThreads, 1);
+
+            parallelFor(0, numBlocks * numBlocks, [&](int b){
+                int I = b / numBlocks, J = b % numBlocks;
+                if(I == K || J == K) return;
+                minPlusBlock(distance.data(), nextHop.data(), N, I, J, K);
+            }, numThreads, 1);
+
+            // stop as soon as a cycle shows up, going on would only drag more distances down to -INF
+            for(int i = 0; i < N; i++){
+                if(distance[(size_t)i * N + i] < 0) return true;
             }
         }
+        return false;
+    }
 
-        bfGraph.erase(bfNode);
+    template <class T, class W>
+    std::tuple<WeightedAdjacencyMatrix<T, typename WeightTraits<W>::Distance>, WeightedAdjacencyMatrix<T>> WeightedTraversals<T, W>::floydWarshallMatrix(CompressedGraph<T, W>& graph, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return floydWarshallMatrix(weightedGraph, numThreads); }
+        auto adjMat = denseWeights(graph);
+        return floydWarshallMatrix(adjMat, std::numeric_limits<W>::max(), numThreads);
+    }
 
-        std::map<std::pair<Node<T>*, Node<T>*>, int> distMat;
-        std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>> paths;
-        // perform djikstra on all nodes.
-        for(auto [node, nodeAdjList] : bfGraph){
-            for(auto [baseNode, nodeAdjList] : bfGraph){
-                auto [length, path] = djikstraShortestPath(bfGraph, node, baseNode);
-                distMat[{node, baseNode}] = length; 
-                paths[{node, baseNode}] = path;
+    template <class T, class W>
+    std::vector<int> WeightedTraversals<T, W>::nextHopPath(WeightedAdjacencyMatrix<T>& nextHop, int from, int to){
+        std::vector<int> path;
+        int V = nextHop.size();
+        if(from < 0 || from >= V || to < 0 || to >= V || nextHop[from][to] == -1) return path;
+
+        path.push_back(from);
+        while(from != to && int(path.size()) <= V){ // the size cap only matters when a negative cycle left the hops looping
+            from = nextHop[from][to];
+            path.push_back(from);
+        }
+        if(from != to) path.clear();
+        return path;
+    }
+
+    /*
+        Relaxes tile (iBlock, jBlock) through the pivots of tile kBlock:
+
+            d[i][j] = min(d[i][j], d[i][k] + d[k][j])
+
+        k has to be the outer loop, since in phases 1 and 2 the tile being written is also one of
+        the tiles being read. For a fixed (i, k) the j loop is a broadcast add, compare and blend
+        over a contiguous row- 8 lanes with AVX2, 4 with SSE2 (which has no blend, so and/andnot/or).
+        An INF d[k][j] is masked out explicitly, a negative d[i][k] would otherwise pull it below INF.
+        Candidates are clamped at -INF: inside one pivot tile a negative cycle can double a distance
+        every pivot, and clamped operands keep every sum inside D. Only int tiles are vectorized,
+        wider distances go through the scalar loop.
+    */
+    template <class T, class W>
+    template <class D>
+    void WeightedTraversals<T, W>::minPlusBlock(D* distance, int* nextHop, int stride, int iBlock, int jBlock, int kBlock){
+        const int B = FLOYD_WARSHALL_BLOCK;
+        const D INF = floydWarshallInfinity<D>();
+
+        for(int k = kBlock * B; k < (kBlock + 1) * B; k++){
+            const D* distanceFromK = distance + (size_t)k * stride + jBlock * B;
+
+            for(int i = iBlock * B; i < (iBlock + 1) * B; i++){
+                D throughK = distance[(size_t)i * stride + k];
+                if(throughK >= INF) continue;
+                int hop = nextHop[(size_t)i * stride + k];
+
+                D* distanceFromI = distance + (size_t)i * stride + jBlock * B;
+                int* nextHopFromI = nextHop + (size_t)i * stride + jBlock * B;
+                int j = 0;
+
+                if constexpr(std::is_same<D, int>::value){
+#if defined(__AVX2__)
+                    const __m256i inf = _mm256_set1_epi32(INF);
+                    const __m256i negativeInf = _mm256_set1_epi32(-INF);
+                    const __m256i viaK = _mm256_set1_epi32(throughK);
+                    const __m256i hops = _mm256_set1_epi32(hop);
+                    for(; j + 8 <= B; j += 8){
+                        __m256i kj = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(distanceFromK + j));
+                        __m256i ij = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(distanceFromI + j));
+                        __m256i candidate = _mm256_max_epi32(_mm256_add_epi32(kj, viaK), negativeInf);
+                        __m256i better = _mm256_and_si256(_mm256_cmpgt_epi32(ij, candidate), _mm256_cmpgt_epi32(inf, kj));
+
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(distanceFromI + j), _mm256_blendv_epi8(ij, candidate, better));
+                        __m256i currentHops = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nextHopFromI + j));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(nextHopFromI + j), _mm256_blendv_epi8(currentHops, hops, better));
+                    }
+#elif defined(__SSE2__)
+                    const __m128i inf = _mm_set1_epi32(INF);
+                    const __m128i negativeInf = _mm_set1_epi32(-INF);
+                    const __m128i viaK = _mm_set1_epi32(throughK);
+                    const __m128i hops = _mm_set1_epi32(hop);
+                    for(; j + 4 <= B; j += 4){
+                        __m128i kj = _mm_loadu_si128(reinterpret_cast<const __m128i*>(distanceFromK + j));
+                        __m128i ij = _mm_loadu_si128(reinterpret_cast<const __m128i*>(distanceFromI + j));
+                        __m128i candidate = _mm_add_epi32(kj, viaK);
+                        __m128i tooLow = _mm_cmpgt_epi32(negativeInf, candidate); // no max_epi32 before SSE4.1
+                        candidate = _mm_or_si128(_mm_and_si128(tooLow, negativeInf), _mm_andnot_si128(tooLow, candidate));
+                        __m128i better = _mm_and_si128(_mm_cmpgt_epi32(ij, candidate), _mm_cmpgt_epi32(inf, kj));
+
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(distanceFromI + j), _mm_or_si128(_mm_and_si128(better, candidate), _mm_andnot_si128(better, ij)));
+                        __m128i currentHops = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nextHopFromI + j));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(nextHopFromI + j), _mm_or_si128(_mm_and_si128(better, hops), _mm_andnot_si128(better, currentHops)));
+                    }
+#endif
+                }
+
+                for(; j < B; j++){
+                    if(distanceFromK[j] >= INF) continue;
+                    D candidate = std::max<D>(throughK + distanceFromK[j], -INF);
+                    if(candidate < distanceFromI[j]){
+                        distanceFromI[j] = candidate;
+                        nextHopFromI[j] = hop;
+                    }
+                }
             }
         }
-        return {distMat, paths};
     }
 
-    template <class T>
-    int WeightedTraversals<T>::travellingSalesmanProblem(WeightedGraph<T> graph, Node<T>* start){
-        auto [adjMat, nodeToIndex] = graph.weightedAdjacencyMatrix();
+    /*
+        Johnson: Bellman-Ford potentials make every edge weight non-negative
+        (W_uv_new = W_uv_old + h_u - h_v), then one Dijkstra per source- not one per pair- gives
+        that source's whole row, and the original lengths come back as d_new(u, v) - h_u + h_v.
+
+        The potentials are Bellman-Ford from a virtual node with a 0 weighted edge to every node,
+        which is the same as starting every distance at 0, so the virtual node never has to exist.
 
-        adjMat.print();
+        The searches only read the reweighted graph and each one writes its own row, so sources
+        are handed out over numThreads threads, each reusing one pair of scratch arrays.
+    */
+    template <class T, class W>
+    std::tuple<WeightedAdjacencyMatrix<T, typename WeightTraits<W>::Distance>, WeightedAdjacencyMatrix<T>> WeightedTraversals<T, W>::johnsonMatrix(CompressedGraph<T, W>& graph, bool withPredecessors, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return johnsonMatrix(weightedGraph, withPredecessors, numThreads); }
+        int V = graph.size();
+
+        std::vector<Distance> potential(V, 0);
+        std::vector<int> unusedPreviousNode(V, -1);
+        if(!spfa(graph, potential, unusedPreviousNode)){
+            ErrorHandling<T> handler;
+            handler.checkNoNegativeCycle(true);
+            return {WeightedAdjacencyMatrix<T, Distance>(0), WeightedAdjacencyMatrix<T>(0)};
+        }
+
+        // weight updation, into Distance since h_u - h_v can be far outside W
+        CompressedGraph<T, Distance> reweightedGraph;
+        reweightedGraph.offsets = graph.offsets;
+        reweightedGraph.targets = graph.targets;
+        reweightedGraph.nodes = graph.nodes;
+        reweightedGraph.nodeToIndex = graph.nodeToIndex;
+        reweightedGraph.weights.resize(graph.targets.size());
+        for(int u = 0; u < V; u++){
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++){
+                reweightedGraph.weights[e] = Distance(graph.weights[e]) + potential[u] - potential[graph.targets[e]];
+            }
+        }
+
+        WeightedAdjacencyMatrix<T, Distance> distances(V, WeightTraits<W>::unreachable());
+        WeightedAdjacencyMatrix<T> predecessors(withPredecessors ? V : 0, -1);
 
-        auto nodes = graph.getAllNodes();
+        int threads = resolveNumThreads(numThreads, V);
+        std::vector<std::vector<Distance>> threadDistance(threads, std::vector<Distance>(V));
+        std::vector<std::vector<int>> threadPreviousNode(threads, std::vector<int>(V));
 
-        auto nodesWithoutStart = nodes;
-        nodesWithoutStart.erase(std::remove(nodes.begin(), nodes.end(), start));
+        parallelFor(0, V, [&](int u, int threadId){
+            std::vector<Distance>& nodeDistance = threadDistance[threadId];
+            std::vector<int>& previousNode = threadPreviousNode[threadId];
+            std::fill(nodeDistance.begin(), nodeDistance.end(), WeightTraits<W>::unreachable());
+            std::fill(previousNode.begin(), previousNode.end(), -1);
 
-        return travellingSalesmanProblemRecurse(start, start, nodesWithoutStart, adjMat, nodeToIndex);
-        
+            heapDijkstra(reweightedGraph, u, -1, nodeDistance, previousNode);
+
+            Distance* distanceRow = distances.data() + (size_t)u * V;
+            for(int v = 0; v < V; v++){
+                if(nodeDistance[v] != WeightTraits<W>::unreachable()) distanceRow[v] = nodeDistance[v] - potential[u] + potential[v];
+            }
+            if(withPredecessors) std::copy(previousNode.begin(), previousNode.end(), predecessors.data() + (size_t)u * V);
+        }, threads, 1);
+
+        return {distances, predecessors};
     }
-    
-    template <class T>
-    WeightedGraph<T> WeightedTraversals<T>::kruskalMinimumSpanningTree(WeightedGraph<T> graph){
-        auto edgeList = graph.weightedEdgeList();
 
-        // sort by weighted (pair_element->second)
-        std::sort(edgeList.begin(), edgeList.end(), [](auto &left, auto &right) { return std::get<2>(left) < std::get<2>(right); });
+    template <class T, class W>
+    std::vector<int> WeightedTraversals<T, W>::predecessorPath(WeightedAdjacencyMatrix<T>& predecessor, int from, int to){
+        std::vector<int> path;
+        int V = predecessor.size();
+        if(from < 0 || from >= V || to < 0 || to >= V) return path;
+        if(from != to && predecessor[from][to] == -1) return path;
 
-        typename std::vector<WeightedEdgeList<T>>::iterator emptyIt = {};
+        for(int currentBackTrackedNode = to; currentBackTrackedNode != -1; currentBackTrackedNode = predecessor[from][currentBackTrackedNode]){
+            path.push_back(currentBackTrackedNode);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
 
-        std::vector<WeightedEdgeList<T>> unionFind; // use combine, find ops...
+    // Unreachable pairs get -1 and an empty path, like djikstraShortestPath. On a negative cycle
+    // there are no shortest paths at all, so both maps come back empty.
+    template <class T, class W>
+    std::tuple<std::map<std::pair<Node<T>*, Node<T>*>, typename WeightTraits<W>::Distance>, std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>>> WeightedTraversals<T, W>::johnson(WeightedGraph<T, W> graph){
+        std::map<std::pair<Node<T>*, Node<T>*>, Distance> distMat;
+        std::map<std::pair<Node<T>*, Node<T>*>, std::vector<Node<T>*>> paths;
 
-        for(auto edge : edgeList){ // min to max
-            auto firstIt = emptyIt; 
-            auto secondIt = emptyIt;
-            for(auto it = unionFind.begin(); it != unionFind.end(); it++){
+        CompressedGraph<T, W> compressedGraph(graph);
+        int V = compressedGraph.size();
 
-                auto first = it->find(std::get<0>(edge));
+        auto [distances, predecessors] = johnsonMatrix(compressedGraph, true);
+        if(distances.size() != V) return {distMat, paths};
 
-                if(first != it->end()){ // this can't happen more than once, by defn
-                    firstIt = it;
+        for(int u = 0; u < V; u++){
+            Node<T>* node = compressedGraph.nodes[u];
+            for(int v = 0; v < V; v++){
+                Node<T>* baseNode = compressedGraph.nodes[v];
+                if(distances[u][v] == WeightTraits<W>::unreachable()){
+                    distMat[{node, baseNode}] = -1;
+                    paths[{node, baseNode}] = {};
+                    continue;
                 }
+                distMat[{node, baseNode}] = distances[u][v];
+                for(auto w : predecessorPath(predecessors, u, v)) paths[{node, baseNode}].push_back(compressedGraph.nodes[w]);
+            }
+        }
+        return {distMat, paths};
+    }
+
+    template <class T, class W>
+    typename WeightTraits<W>::Distance WeightedTraversals<T, W>::travellingSalesmanProblem(WeightedGraph<T, W> graph, Node<T>* start){
+        auto [length, tour] = travellingSalesmanTour(graph, start);
+        return length;
+    }
+
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::travellingSalesmanTour(WeightedGraph<T, W>& graph, Node<T>* start, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto it = compressedGraph.nodeToIndex.find(start);
+        if(it == compressedGraph.nodeToIndex.end()) return {-1, {}};
+
+        auto adjMat = denseWeights(compressedGraph);
+        auto [length, tour] = travellingSalesmanTour(adjMat, it->second, std::numeric_limits<W>::max(), numThreads);
 
-                auto second = it->find(std::get<1>(edge));
+        std::vector<Node<T>*> tourNodes;
+        for(auto v : tour) tourNodes.push_back(compressedGraph.nodes[v]);
+        return {length, tourNodes};
+    }
+
+    /*
+        Held-Karp. With the start fixed, cost[subset][last] is the cheapest path that leaves the
+        start, visits exactly the nodes in subset and ends at last:
+
+            cost[subset][last] = min over k of cost[subset - last][k] + w(k, last)
+
+        Every subset only reads subsets one smaller, so the table is filled a layer (subset size)
+        at a time and each layer is spread over threads. Only the costs are stored- the tour is
+        recovered afterwards by finding, at each step back, a k whose cost plus edge matches exactly,
+        which saves a second table as big as the first.
+    */
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<int>> WeightedTraversals<T, W>::travellingSalesmanTour(WeightedAdjacencyMatrix<T, W>& adjMat, int start, W noEdge, int numThreads){
+        int V = adjMat.size();
+        if(start < 0 || start >= V) return {-1, {}};
+        if(V > MAX_HELD_KARP_NODES){ // the table wouldn't fit, see MAX_HELD_KARP_NODES
+            ErrorHandling<T> handler;
+            handler.checkExactTourSize(V, MAX_HELD_KARP_NODES);
+            return approximateTravellingSalesmanTour(adjMat, start, 1.0, noEdge);
+        }
+        if(V == 1) return {0, {start, start}};
+
+        // bit b of a subset stands for others[b]
+        std::vector<int> others;
+        for(int v = 0; v < V; v++){
+            if(v != start) others.push_back(v);
+        }
+        int m = V - 1;
+
+        // missing edges and paths are both NO_PATH
+        const Distance NO_PATH = WeightTraits<W>::unreachable();
+        auto weight = [&](int u, int v){
+            W w = adjMat.data()[(size_t)u * V + v];
+            return w != noEdge && w < std::numeric_limits<W>::max() ? Distance(w) : NO_PATH;
+        };
+        std::vector<Distance> between(m * m), fromStart(m), toStart(m);
+        for(int a = 0; a < m; a++){
+            fromStart[a] = weight(start, others[a]);
+            toStart[a] = weight(others[a], start);
+            for(int b = 0; b < m; b++) between[a * m + b] = weight(others[a], others[b]);
+        }
+
+        int numSubsets = 1 << m;
+        std::vector<Distance> cost((size_t)numSubsets * m, NO_PATH); // a last outside of subset stays NO_PATH, so it never has to be checked
+
+        std::vector<std::vector<int>> layers(m + 1);
+        for(int subset = 1; subset < numSubsets; subset++) layers[__builtin_popcount(subset)].push_back(subset);
 
-                if(second != it->end()){
-                    secondIt = it; 
+        for(int b = 0; b < m; b++) cost[(size_t)(1 << b) * m + b] = fromStart[b];
+
+        for(int size = 2; size <= m; size++){
+            std::vector<int>& layer = layers[size];
+            parallelFor(0, int(layer.size()), [&](int i){
+                int subset = layer[i];
+                Distance* subsetCost = cost.data() + (size_t)subset * m;
+
+                for(int last = 0; last < m; last++){
+                    if(!(subset >> last & 1)) continue;
+                    const Distance* previousCost = cost.data() + (size_t)(subset ^ (1 << last)) * m;
+
+                    Distance best = NO_PATH;
+                    for(int k = 0; k < m; k++){
+                        if(previousCost[k] == NO_PATH || between[k * m + last] == NO_PATH) continue;
+                        best = std::min(best, previousCost[k] + between[k * m + last]);
+                    }
+                    subsetCost[last] = best;
                 }
+            }, numThreads);
+        }
+
+        int full = numSubsets - 1;
+        Distance length = NO_PATH;
+        int last = -1;
+        for(int b = 0; b < m; b++){
+            Distance c = cost[(size_t)full * m + b];
+            if(c == NO_PATH || toStart[b] == NO_PATH) continue;
+            if(c + toStart[b] < length){
+                length = c + toStart[b];
+                last = b;
             }
+        }
+        if(last == -1) return {-1, {}}; // no tour
+
+        std::vector<int> tour = {start};
+        for(int subset = full; ; ){
+            tour.push_back(others[last]);
+            int previousSubset = subset ^ (1 << last);
+            if(previousSubset == 0) break;
+
+            Distance target = cost[(size_t)subset * m + last];
+            const Distance* previousCost = cost.data() + (size_t)previousSubset * m;
+            for(int k = 0; k < m; k++){
+                if(previousCost[k] != NO_PATH && between[k * m + last] != NO_PATH && previousCost[k] + between[k * m + last] == target){
+                    last = k;
+                    break;
+                }
+            }
+            subset = previousSubset;
+        }
+        tour.push_back(start);
+        std::reverse(tour.begin(), tour.end()); // it was walked back from the last stop
+        return {length, tour};
+    }
 
-            if(firstIt == emptyIt && secondIt == emptyIt){
-                WeightedEdgeList<T> group;
-                group.addEdge(edge);
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<Node<T>*>> WeightedTraversals<T, W>::approximateTravellingSalesmanTour(WeightedGraph<T, W>& graph, Node<T>* start, double timeLimitSeconds, unsigned seed){
+        CompressedGraph<T, W> compressedGraph(graph);
+        auto it = compressedGraph.nodeToIndex.find(start);
+        if(it == compressedGraph.nodeToIndex.end()) return {-1, {}};
 
-                unionFind.push_back(group);
+        auto adjMat = denseWeights(compressedGraph);
+        auto [length, tour] = approximateTravellingSalesmanTour(adjMat, it->second, timeLimitSeconds, std::numeric_limits<W>::max(), seed);
+
+        std::vector<Node<T>*> tourNodes;
+        for(auto v : tour) tourNodes.push_back(compressedGraph.nodes[v]);
+        return {length, tourNodes};
+    }
+
+    /*
+        An anytime search: a nearest neighbor tour is improved to a local optimum, and then as long
+        as there's time left the best tour gets a random double bridge kick (a 4-opt move local search
+        can't easily undo) and is improved again, keeping the result only if it's shorter.
+
+        Moves are only tried towards each node's few nearest neighbors, and a node whose moves all
+        failed isn't looked at again until one of its tour neighbors changes (don't-look bits), so
+        a local optimum costs about O(V * numNeighbors) checks instead of O(V^2) per pass.
+    */
+    template <class T, class W>
+    std::tuple<typename WeightTraits<W>::Distance, std::vector<int>> WeightedTraversals<T, W>::approximateTravellingSalesmanTour(WeightedAdjacencyMatrix<T, W>& adjMat, int start, double timeLimitSeconds, W noEdge, unsigned seed){
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::max(0.0, timeLimitSeconds)));
+
+        int V = adjMat.size();
+        if(start < 0 || start >= V) return {-1, {}};
+        if(V <= 12) return travellingSalesmanTour(adjMat, start, noEdge); // a couple of milliseconds for the exact answer
+
+        LocalSearchTour tour;
+        tour.V = V;
+        tour.weights = adjMat.data();
+        tour.noEdge = noEdge;
+        // a missing edge costs more than a whole tour of real ones, but V of them still have to add up without overflowing
+        long double heaviest = 0;
+        for(int u = 0; u < V; u++){
+            for(int v = 0; v < V; v++){
+                if(u != v && tour.isEdge(u, v)) heaviest = std::max(heaviest, std::fabs((long double)adjMat.data()[(size_t)u * V + v]));
             }
-            else if(firstIt == secondIt){
-                // just do nothing..
+        }
+        tour.missingCost = Distance(std::min((heaviest + 1) * V, (long double)WeightTraits<W>::unreachable() / (8 * (long double)V)));
+        tour.symmetric = true;
+        for(int u = 0; u < V && tour.symmetric; u++){
+            for(int v = u + 1; v < V; v++){
+                if(tour.cost(u, v) != tour.cost(v, u)){
+                    tour.symmetric = false;
+                    break;
+                }
             }
-            else if(firstIt != emptyIt && secondIt == emptyIt){
-                firstIt->addEdge(edge);
+        }
+
+        tour.numNeighbors = std::min(10, V - 1);
+        tour.neighbors.resize((size_t)V * tour.numNeighbors);
+        std::vector<int> candidates;
+        for(int u = 0; u < V; u++){
+            candidates.clear();
+            for(int v = 0; v < V; v++){
+                if(v != u) candidates.push_back(v);
             }
-            else if(firstIt == emptyIt && secondIt != emptyIt){
-                secondIt->addEdge(edge);
+            std::partial_sort(candidates.begin(), candidates.begin() + tour.numNeighbors, candidates.end(), [&](int a, int b){ return tour.cost(u, a) < tour.cost(u, b); });
+            std::copy(candidates.begin(), candidates.begin() + tour.numNeighbors, tour.neighbors.begin() + (size_t)u * tour.numNeighbors);
+        }
+
+        std::vector<int> order = {start};
+        std::vector<char> visited(V, 0);
+        visited[start] = 1;
+        for(int step = 1; step < V; step++){
+            int current = order.back(), nearest = -1;
+            for(int v = 0; v < V; v++){
+                if(!visited[v] && (nearest == -1 || tour.cost(current, v) < tour.cost(current, nearest))) nearest = v;
             }
-            else if(firstIt != emptyIt && secondIt != emptyIt){ // arbitrarily choose the first one as a base case
-                firstIt->addEdge(edge);
-                firstIt->combine(*secondIt);
-                unionFind.erase(secondIt);
+            visited[nearest] = 1;
+            order.push_back(nearest);
+        }
 
-                
+        setTourOrder(tour, order);
+        for(int v = 0; v < V; v++) tour.activate(v);
+        localSearch(tour, deadline);
+
+        std::vector<int> bestOrder = tour.order;
+        Distance bestCost = tourCost(tour);
+
+        std::mt19937 rng(seed);
+        // V > 12 here, so there is always room for three distinct cuts
+        while(std::chrono::steady_clock::now() < deadline){
+            // double bridge: A B C D => A C B D
+            int cuts[3];
+            for(int c = 0; c < 3; c++) cuts[c] = 1 + int(rng() % (V - 1));
+            std::sort(cuts, cuts + 3);
+            if(cuts[0] == cuts[1] || cuts[1] == cuts[2]) continue;
+
+            std::vector<int> kicked(bestOrder.begin(), bestOrder.begin() + cuts[0]);
+            kicked.insert(kicked.end(), bestOrder.begin() + cuts[1], bestOrder.begin() + cuts[2]);
+            kicked.insert(kicked.end(), bestOrder.begin() + cuts[0], bestOrder.begin() + cuts[1]);
+            kicked.insert(kicked.end(), bestOrder.begin() + cuts[2], bestOrder.end());
+
+            setTourOrder(tour, kicked);
+            for(int c = 0; c < 3; c++){
+                for(int offset = -1; offset <= 0; offset++) tour.activate(kicked[(cuts[c] + offset + V) % V]);
+            }
+            tour.activate(kicked[0]);
+            tour.activate(kicked[V-1]);
+            localSearch(tour, deadline);
+
+            Distance cost = tourCost(tour);
+            if(cost < bestCost){
+                bestCost = cost;
+                bestOrder = tour.order;
             }
         }
 
-        return unionFind[0].weightedGraph(); // Guaranteed to be of size 1..
+        for(int i = 0; i < V; i++){
+            if(!tour.isEdge(bestOrder[i], bestOrder[i + 1 == V ? 0 : i + 1])) return {-1, {}}; // every tour found needs a missing edge
+        }
+
+        std::rotate(bestOrder.begin(), std::find(bestOrder.begin(), bestOrder.end(), start), bestOrder.end());
+        bestOrder.push_back(start);
+        return {bestCost, bestOrder};
     }
 
-    template <class T>
-    WeightedGraph<T> WeightedTraversals<T>::primMinimumSpanningTree(WeightedGraph<T> graph){
-        auto currentNode = graph.begin()->first;
-        auto edgeList = graph.weightedEdgeList();
+    template <class T, class W>
+    void WeightedTraversals<T, W>::setTourOrder(LocalSearchTour& tour, const std::vector<int>& order){
+        tour.order = order;
+        tour.position.resize(tour.V);
+        for(int i = 0; i < tour.V; i++) tour.position[order[i]] = i;
+        tour.active.clear();
+        tour.queued.assign(tour.V, 0);
+    }
 
-        WeightedEdgeList<T> MST;
+    template <class T, class W>
+    typename WeightTraits<W>::Distance WeightedTraversals<T, W>::tourCost(LocalSearchTour& tour){
+        Distance cost = 0;
+        for(int i = 0; i < tour.V; i++) cost += tour.cost(tour.order[i], tour.order[i + 1 == tour.V ? 0 : i + 1]);
+        return cost;
+    }
 
-        std::set<Node<T>*> pickedNodes = {};
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::localSearch(LocalSearchTour& tour, std::chrono::steady_clock::time_point deadline){
+        for(int checked = 1; !tour.active.empty(); checked++){
+            if(checked % 128 == 0 && std::chrono::steady_clock::now() >= deadline) return false;
 
-        while(pickedNodes.size() != graph.size()){ // all nodes are picked
-            pickedNodes.insert(currentNode);
+            int a = tour.active.front();
+            tour.active.pop_front();
+            tour.queued[a] = 0;
+            if(improveFrom(tour, a)) tour.activate(a);
+        }
+        return true;
+    }
 
+    // Tries the moves that touch a's tour edges, applies the first one that shortens the tour.
+    template <class T, class W>
+    bool WeightedTraversals<T, W>::improveFrom(LocalSearchTour& tour, int a){
+        int V = tour.V;
+        const int* neighbors = tour.neighbors.data() + (size_t)a * tour.numNeighbors;
+
+        // 2-opt: drop (a, b) and (c, d), add (a, c) and (b, d), on either side of a.
+        // neighbors are nearest first, so once w(a, c) >= w(a, b) no c further down can gain anything
+        if(tour.symmetric && V >= 4){
+            for(int side = 0; side < 2; side++){
+                int b = side == 0 ? tour.next(a) : tour.previous(a);
+                Distance ab = tour.cost(a, b);
+
+                for(int i = 0; i < tour.numNeighbors; i++){
+                    int c = neighbors[i];
+                    Distance ac = tour.cost(a, c);
+                    if(ac >= ab) break;
+
+                    int d = side == 0 ? tour.next(c) : tour.previous(c);
+                    if(c == b || d == a) continue;
+
+                    Distance gain = ab + tour.cost(c, d) - ac - tour.cost(b, d);
+                    if(gain <= 0) continue;
+
+                    if(side == 0) reverseTourPath(tour, b, c); // a b .. c d => a c .. b d
+                    else reverseTourPath(tour, a, d); // d c .. b a => d b .. c a
+                    tour.activate(b);
+                    tour.activate(c);
+                    tour.activate(d);
+                    return true;
+                }
+            }
+        }
 
-            WeightedEdgeList<T> minEdgeList;
-            for(auto it = pickedNodes.begin(); it != pickedNodes.end(); it++){
-                std::tuple<Node<T>*, Node<T>*, int> edge;                
-                auto tempEdgeList = edgeList;
-                while(MST.find(edge) != MST.end() || std::get<0>(edge) != *it || std::find(pickedNodes.begin(), pickedNodes.end(), std::get<1>(edge))  != pickedNodes.end()){
-                    if(tempEdgeList.size() == 0) break;
-                    edge = tempEdgeList.minEdge();
-                    tempEdgeList.erase(edge); // this is an overloaded erase function
+        // Or-opt: move the 1 to 3 nodes starting at a to between some c and its successor, as is or flipped
+        for(int length = 1; length <= 3 && length + 2 < V; length++){
+            int first = a, last = a;
+            for(int step = 1; step < length; step++) last = tour.next(last);
+            int p = tour.previous(first), n = tour.next(last);
+
+            Distance removed = tour.cost(p, first) + tour.cost(last, n) - tour.cost(p, n);
+            if(removed <= 0) continue;
+
+            for(int end = 0; end < 2; end++){
+                const int* candidates = tour.neighbors.data() + (size_t)(end == 0 ? first : last) * tour.numNeighbors;
+                for(int i = 0; i < tour.numNeighbors; i++){
+                    int c = candidates[i];
+                    if(c == p || (tour.position[c] - tour.position[first] + V) % V < length) continue;
+                    int d = tour.next(c);
+
+                    Distance forward = tour.cost(c, first) + tour.cost(last, d) - tour.cost(c, d);
+                    Distance flipped = tour.symmetric ? tour.cost(c, last) + tour.cost(first, d) - tour.cost(c, d) : WeightTraits<W>::unreachable();
+                    if(std::min(forward, flipped) >= removed) continue;
+
+                    moveTourSegment(tour, first, length, c, flipped < forward);
+                    tour.activate(p);
+                    tour.activate(n);
+                    tour.activate(last);
+                    tour.activate(c);
+                    tour.activate(d);
+                    return true;
                 }
-                minEdgeList.addEdge(edge);
             }
+        }
+        return false;
+    }
+
+    // Reverses the stretch from .. to (following the tour), or the rest of the tour if that's shorter-
+    // for a symmetric tour both give the same cycle.
+    template <class T, class W>
+    void WeightedTraversals<T, W>::reverseTourPath(LocalSearchTour& tour, int from, int to){
+        int V = tour.V;
+        int left = tour.position[from], right = tour.position[to];
+        int length = (right - left + V) % V + 1;
+        if(2 * length > V){
+            left = (right + 1) % V;
+            right = (tour.position[from] - 1 + V) % V;
+            length = V - length;
+        }
 
-            auto edge = minEdgeList.minEdge();         
-            pickedNodes.insert(std::get<0>(edge));
-            pickedNodes.insert(std::get<1>(edge));
-            currentNode = std::get<1>(edge);
-            MST.addEdge(edge);
-        }   
-        return MST.weightedGraph();
+        for(int step = 0; step < length / 2; step++){
+            std::swap(tour.order[left], tour.order[right]);
+            tour.position[tour.order[left]] = left;
+            tour.position[tour.order[right]] = right;
+            left = left + 1 == V ? 0 : left + 1;
+            right = right == 0 ? V - 1 : right - 1;
+        }
     }
 
-    template <class T>
-    int WeightedTraversals<T>::travellingSalesmanProblemRecurse(Node<T>* start, Node<T>* node, std::vector<Node<T>*>& nodesLeft, WeightedAdjacencyMatrix<T>& adjMat, std::map<Node<T>*, int>& nodeToIndex){
-        if(nodesLeft.size() == 0){
-            return adjMat[nodeToIndex[node]][nodeToIndex[start]]; // row is node, col is start. 
+    template <class T, class W>
+    void WeightedTraversals<T, W>::moveTourSegment(LocalSearchTour& tour, int first, int length, int after, bool reversed){
+        int V = tour.V;
+        std::vector<int> segment;
+        int node = first;
+        for(int i = 0; i < length; i++, node = tour.next(node)) segment.push_back(node);
+        if(reversed) std::reverse(segment.begin(), segment.end());
+
+        // node is now right after the segment, walk the rest of the tour from there
+        std::vector<int> order;
+        order.reserve(V);
+        for(int i = 0; i < V - length; i++, node = tour.next(node)){
+            order.push_back(node);
+            if(node == after) order.insert(order.end(), segment.begin(), segment.end());
         }
-        
-        int finalVal = INT_MAX; 
-        for(int i = 0; i < nodesLeft.size(); i++){
-            auto currentNodesLeft = nodesLeft; 
-            currentNodesLeft.erase(std::remove(currentNodesLeft.begin(), currentNodesLeft.end(), nodesLeft[i]));
-            finalVal = std::min(finalVal, adjMat[nodeToIndex[node]][nodeToIndex[nodesLeft[i]]] + travellingSalesmanProblemRecurse(start, nodesLeft[i], currentNodesLeft, adjMat, nodeToIndex));
+
+        tour.order = order;
+        for(int i = 0; i < V; i++) tour.position[order[i]] = i;
+    }
+
+    template <class T, class W>
+    template <class EdgeWeight>
+    WeightedAdjacencyMatrix<T, EdgeWeight> WeightedTraversals<T, W>::denseWeights(CompressedGraph<T, EdgeWeight>& graph){
+        int V = graph.size();
+        WeightedAdjacencyMatrix<T, EdgeWeight> adjMat(V, std::numeric_limits<EdgeWeight>::max());
+        for(int u = 0; u < V; u++){
+            EdgeWeight* row = adjMat.data() + (size_t)u * V;
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++){
+                row[graph.targets[e]] = std::min(row[graph.targets[e]], graph.weights[e]);
+            }
         }
+        return adjMat;
+    }
+
+    template <class T, class W>
+    std::vector<unsigned int> WeightedTraversals<T, W>::weightKeys(CompressedGraph<T, W>& graph, int numThreads){
+        int E = int(graph.weights.size());
+        std::vector<unsigned int> keys(E);
+        if constexpr(DIRECT_WEIGHT_KEYS){
+            parallelFor(0, E, [&](int e){
+                keys[e] = (unsigned int)int(graph.weights[e]) ^ 0x80000000u;
+            }, numThreads);
+            return keys;
+        }
+
+        std::vector<W> distinctWeights = graph.weights;
+        parallelSort(distinctWeights.begin(), distinctWeights.end(), numThreads);
+        distinctWeights.erase(std::unique(distinctWeights.begin(), distinctWeights.end()), distinctWeights.end());
+        parallelFor(0, E, [&](int e){
+            keys[e] = (unsigned int)(std::lower_bound(distinctWeights.begin(), distinctWeights.end(), graph.weights[e]) - distinctWeights.begin());
+        }, numThreads);
+        return keys;
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W> WeightedTraversals<T, W>::kruskalMinimumSpanningTree(WeightedGraph<T, W> graph){
+        return kruskalMinimumSpanningForest(graph).weightedGraph();
+    }
+
+    template <class T, class W>
+    std::vector<std::string> WeightedTraversals<T, W>::validKruskalMethods(){
+        return {"sort", "filter"};
+    }
+
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::kruskalMinimumSpanningForest(WeightedGraph<T, W>& graph, std::string kruskalMethod, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return kruskalMinimumSpanningForest(compressedGraph, kruskalMethod, numThreads);
+    }
 
-        return finalVal;
+    /*
+        Kruskal: take edges lightest first and keep each one that joins two different trees.
+
+        Every edge is packed into one 64 bit edgeKey, so the sort moves plain integers and equal
+        weights come out in a fixed order. The trees are a DisjointSet over CSR indices.
+    */
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::kruskalMinimumSpanningForest(CompressedGraph<T, W>& graph, std::string kruskalMethod, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return kruskalMinimumSpanningForest(weightedGraph, kruskalMethod, numThreads); }
+        ErrorHandling<T> handler;
+        handler.checkUnknownKruskalMethod(kruskalMethod, validKruskalMethods()); // reported, then treated like "sort"
+
+        int V = graph.size();
+        int E = int(graph.targets.size());
+        SpanningForest<T, W> forest(graph);
+
+        std::vector<int> edgeSource(E);
+        std::vector<unsigned int> keys = weightKeys(graph, numThreads);
+        std::vector<unsigned long long> edgeKeys;
+        edgeKeys.reserve(E);
+        for(int u = 0; u < V; u++){
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++){
+                edgeSource[e] = u;
+                if(graph.targets[e] == u) continue; // a self loop never joins anything
+                edgeKeys.push_back(edgeKey(keys[e], e));
+            }
+        }
+
+        DisjointSet trees(V);
+        if(kruskalMethod == "filter"){
+            std::mt19937 rng(0);
+            filterKruskal(graph, edgeSource, edgeKeys.data(), edgeKeys.data() + edgeKeys.size(), trees, forest, rng);
+            return forest;
+        }
+
+        parallelSort(edgeKeys.begin(), edgeKeys.end(), numThreads);
+        for(auto key : edgeKeys){
+            if(trees.numSets() == 1) break; // spanning already, everything left would close a cycle
+            int e = edgeOf(key);
+            if(trees.unite(edgeSource[e], graph.targets[e])) forest.addEdge(edgeSource[e], graph.targets[e], graph.weights[e]);
+        }
+        return forest;
+    }
+
+    /*
+        Filter-Kruskal (Osipov, Sanders & Singler). Split the edges around a random pivot like
+        quicksort and finish the light half first. By then many heavy edges join two nodes that are
+        already in one tree, so they're thrown out before anyone pays to sort them. On graphs where
+        most heavy edges are redundant that's most of the sorting work gone.
+    */
+    template <class T, class W>
+    void WeightedTraversals<T, W>::filterKruskal(CompressedGraph<T, W>& graph, std::vector<int>& edgeSource, unsigned long long* begin, unsigned long long* end, DisjointSet& trees, SpanningForest<T, W>& forest, std::mt19937& rng){
+        if(begin == end || trees.numSets() == 1) return;
+
+        auto kruskal = [&](unsigned long long* first, unsigned long long* last){
+            std::sort(first, last);
+            for(auto it = first; it != last && trees.numSets() > 1; it++){
+                int e = edgeOf(*it);
+                if(trees.unite(edgeSource[e], graph.targets[e])) forest.addEdge(edgeSource[e], graph.targets[e], graph.weights[e]);
+            }
+        };
+        auto filter = [&](unsigned long long* first, unsigned long long* last){
+            return std::remove_if(first, last, [&](unsigned long long key){
+                int e = edgeOf(key);
+                return trees.connected(edgeSource[e], graph.targets[e]);
+            });
+        };
+
+        if(end - begin <= FILTER_KRUSKAL_THRESHOLD){
+            kruskal(begin, end);
+            return;
+        }
+
+        // three ways on the weight: lighter | as heavy as the pivot | heavier. The pivot's own band is never
+        // empty, so both recursions get fewer edges than this call even when most edges tie with the pivot..
+        // and the band itself is already in order but for edge indices, one sort and it's done
+        unsigned long long pivotWeight = begin[rng() % (end - begin)] >> 32;
+        unsigned long long* lighter = std::partition(begin, end, [&](unsigned long long key){ return (key >> 32) < pivotWeight; });
+        unsigned long long* heavier = std::partition(lighter, end, [&](unsigned long long key){ return (key >> 32) == pivotWeight; });
+
+        filterKruskal(graph, edgeSource, begin, lighter, trees, forest, rng);
+        if(trees.numSets() == 1) return;
+        kruskal(lighter, filter(lighter, heavier));
+        filterKruskal(graph, edgeSource, heavier, filter(heavier, end), trees, forest, rng);
+    }
+
+    template <class T, class W>
+    WeightedGraph<T, W> WeightedTraversals<T, W>::primMinimumSpanningTree(WeightedGraph<T, W> graph){
+        return primMinimumSpanningForest(graph).weightedGraph();
+    }
+
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::primMinimumSpanningForest(WeightedGraph<T, W>& graph){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return primMinimumSpanningForest(compressedGraph);
+    }
+
+    /*
+        Prim: grow a tree from a root, always adding the lightest edge out of it. The frontier is
+        an IndexedHeap keyed by the lightest known edge into each node, which decreaseKey lowers
+        in place. When the frontier runs dry the component is done and the next unreached node
+        roots the next tree. Works on the undirected view, so a forest edge may point either way.
+    */
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::primMinimumSpanningForest(CompressedGraph<T, W>& graph){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return primMinimumSpanningForest(weightedGraph); }
+        auto undirectedGraph = graph.undirected();
+        int V = undirectedGraph.size();
+        SpanningForest<T, W> forest(graph);
+
+        std::vector<char> inTree(V, 0);
+        std::vector<int> parent(V, -1);
+        IndexedHeap<W> frontier(V);
+
+        for(int root = 0; root < V; root++){
+            if(inTree[root]) continue;
+            frontier.push(root, 0);
+
+            while(!frontier.empty()){
+                W weight = frontier.topKey();
+                int currentNode = frontier.pop();
+                inTree[currentNode] = 1;
+                if(parent[currentNode] != -1) forest.addEdge(parent[currentNode], currentNode, weight);
+
+                for(int e = undirectedGraph.offsets[currentNode]; e < undirectedGraph.offsets[currentNode+1]; e++){
+                    int neighbor = undirectedGraph.targets[e];
+                    if(inTree[neighbor]) continue;
+                    if(frontier.pushOrDecrease(neighbor, undirectedGraph.weights[e])) parent[neighbor] = currentNode;
+                }
+            }
+        }
+        return forest;
+    }
+
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::boruvkaMinimumSpanningForest(WeightedGraph<T, W>& graph, int numThreads){
+        CompressedGraph<T, W> compressedGraph(graph);
+        return boruvkaMinimumSpanningForest(compressedGraph, numThreads);
+    }
+
+    /*
+        Boruvka: every component picks its lightest outgoing edge, all of those join the forest
+        at once, and the components they connect merge- so the number of components at least
+        halves per round.
+
+        The edge scan is the parallel part: each edge offers its edgeKey to the components on
+        both of its ends with an atomic min. Since keys break weight ties by edge index, all
+        components agree on one order and the picked edges can never close a cycle. Edges that
+        end up inside a component are then filtered out (in parallel chunks) so later rounds
+        scan less.
+    */
+    template <class T, class W>
+    SpanningForest<T, W> WeightedTraversals<T, W>::boruvkaMinimumSpanningForest(CompressedGraph<T, W>& graph, int numThreads){
+        if(!graph.isWeighted()){ auto weightedGraph = graph.unitWeighted(); return boruvkaMinimumSpanningForest(weightedGraph, numThreads); }
+        const unsigned long long NO_EDGE = ~0ULL;
+        const int CHUNK = 1 << 14;
+
+        int V = graph.size();
+        SpanningForest<T, W> forest(graph);
+        std::vector<unsigned int> keys = weightKeys(graph, numThreads);
+
+        std::vector<int> edgeSource(graph.targets.size());
+        std::vector<int> edges;
+        for(int u = 0; u < V; u++){
+            for(int e = graph.offsets[u]; e < graph.offsets[u+1]; e++){
+                edgeSource[e] = u;
+                if(graph.targets[e] != u) edges.push_back(e);
+            }
+        }
+
+        // a component is named by its DisjointSet root, and every node carries its component's name
+        DisjointSet trees(V);
+        std::vector<int> component(V), components(V), rename(V);
+        for(int v = 0; v < V; v++) component[v] = components[v] = v;
+        std::vector<std::atomic<unsigned long long>> cheapest(V);
+
+        while(!edges.empty()){
+            for(auto c : components) cheapest[c].store(NO_EDGE, std::memory_order_relaxed);
+
+            parallelFor(0, int(edges.size()), [&](int i){
+                int e = edges[i];
+                unsigned long long key = edgeKey(keys[e], e);
+                for(auto c : {component[edgeSource[e]], component[graph.targets[e]]}){
+                    unsigned long long current = cheapest[c].load(std::memory_order_relaxed);
+                    while(key < current && !cheapest[c].compare_exchange_weak(current, key, std::memory_order_relaxed)){ }
+                }
+            }, numThreads, CHUNK);
+
+            for(auto c : components){
+                unsigned long long key = cheapest[c].load(std::memory_order_relaxed);
+                if(key == NO_EDGE) continue;
+                int e = edgeOf(key);
+                if(trees.unite(edgeSource[e], graph.targets[e])) forest.addEdge(edgeSource[e], graph.targets[e], graph.weights[e]); // both ends may pick the same edge
+            }
+
+            std::vector<int> remaining;
+            for(auto c : components){
+                rename[c] = trees.find(c);
+                if(rename[c] == c) remaining.push_back(c);
+            }
+            components.swap(remaining);
+            parallelFor(0, V, [&](int v){
+                component[v] = rename[component[v]];
+            }, numThreads, CHUNK);
+
+            // each chunk compacts its own surviving edges to its front, then the chunks are slid together
+            int numChunks = (int(edges.size()) + CHUNK - 1) / CHUNK;
+            std::vector<int> kept(numChunks);
+            parallelFor(0, numChunks, [&](int chunk){
+                int begin = chunk * CHUNK, end = std::min(int(edges.size()), begin + CHUNK), count = begin;
+                for(int i = begin; i < end; i++){
+                    int e = edges[i];
+                    if(component[edgeSource[e]] != component[graph.targets[e]]) edges[count++] = e;
+                }
+                kept[chunk] = count - begin;
+            }, numThreads, 1);
+
+            int size = 0;
+            for(int chunk = 0; chunk < numChunks; chunk++){
+                std::copy(edges.begin() + chunk * CHUNK, edges.begin() + chunk * CHUNK + kept[chunk], edges.begin() + size);
+                size += kept[chunk];
+            }
+            edges.resize(size);
+        }
+        return forest;
     }
 }
 
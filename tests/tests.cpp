@@ -0,0 +1,636 @@
+#include <iostream>
+#include <vector>
+#include <set>
+#include <queue>
+#include <random>
+#include <string>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include "Graph/Graph.hpp"
+#include "WeightedGraph/WeightedGraph.hpp"
+#include "Node/Node.hpp"
+#include "CompressedGraph/CompressedGraph.hpp"
+#include "WeightedTraversals/WeightedTraversals.hpp"
+#include "Landmarks/Landmarks.hpp"
+#include "ContractionHierarchy/ContractionHierarchy.hpp"
+#include "ReachabilityIndex/ReachabilityIndex.hpp"
+#include "QueryCache/QueryCache.hpp"
+#include "DynamicShortestPathTree/DynamicShortestPathTree.hpp"
+#include "Eccentricity/Eccentricity.hpp"
+#include "Centrality/Centrality.hpp"
+#include "Clustering/Clustering.hpp"
+
+using namespace Graphify;
+
+/*
+    Randomized checks for the search, preprocessing and caching routines. Every routine is compared
+    against a few lines of plain Dijkstra / BFS / brute force on small random graphs, which are
+    slow but too simple to be wrong. Build and run from the repository root:
+
+        g++ tests/tests.cpp -O2 -Wall -o tests.o -I Graphify -std=c++17 -pthread && ./tests.o
+
+    Prints every failed check and exits with 1 if there was one.
+*/
+
+typedef std::vector<std::vector<std::pair<int, int>>> AdjacencyList; // [u] = {v, weight}, same numbering as RandomGraph::nodes
+
+int numChecks = 0;
+int numFailures = 0;
+
+void check(bool condition, std::string what){
+    numChecks++;
+    if(condition) return;
+    numFailures++;
+    if(numFailures <= 50) std::cout << "FAILED: " << what << "\n";
+}
+
+struct RandomGraph{
+    std::vector<Node<int>*> nodes; // nodes[i]->data == i
+    WeightedGraph<int> graph;
+    AdjacencyList adj;
+};
+
+// No self loops or parallel edges, so an edge is identified by its ends. A DAG only has edges i -> j with i < j.
+RandomGraph randomGraph(int V, int E, int minWeight, int maxWeight, std::mt19937& rng, bool dag=false){
+    RandomGraph random;
+    random.adj.resize(V);
+    for(int i = 0; i < V; i++){
+        Node<int>* node = new Node<int>();
+        node->data = i;
+        random.nodes.push_back(node);
+        random.graph.addNode(node, {});
+    }
+    std::set<std::pair<int, int>> edges;
+    for(int attempt = 0; attempt < 20 * E && int(edges.size()) < E; attempt++){
+        int u = rng() % V, v = rng() % V;
+        if(u == v) continue;
+        if(dag && u > v) std::swap(u, v);
+        if(!edges.insert({u, v}).second) continue;
+        int weight = minWeight + int(rng() % (maxWeight - minWeight + 1));
+        random.graph.addEdge(random.nodes[u], {random.nodes[v], weight});
+        random.adj[u].push_back({v, weight});
+    }
+    return random;
+}
+
+// => -1 if unreachable
+std::vector<long long> referenceDijkstra(AdjacencyList& adj, int source){
+    std::vector<long long> distance(adj.size(), -1);
+    std::priority_queue<std::pair<long long, int>, std::vector<std::pair<long long, int>>, std::greater<std::pair<long long, int>>> queue;
+    distance[source] = 0;
+    queue.push({0, source});
+    while(!queue.empty()){
+        auto [d, u] = queue.top();
+        queue.pop();
+        if(d != distance[u]) continue;
+        for(auto [v, weight] : adj[u]){
+            if(distance[v] == -1 || d + weight < distance[v]){
+                distance[v] = d + weight;
+                queue.push({distance[v], v});
+            }
+        }
+    }
+    return distance;
+}
+
+// => hops, -1 if unreachable
+std::vector<int> referenceBFS(AdjacencyList& adj, int source){
+    std::vector<int> distance(adj.size(), -1);
+    std::queue<int> queue;
+    distance[source] = 0;
+    queue.push(source);
+    while(!queue.empty()){
+        int u = queue.front();
+        queue.pop();
+        for(auto [v, weight] : adj[u]){
+            if(distance[v] == -1){
+                distance[v] = distance[u] + 1;
+                queue.push(v);
+            }
+        }
+    }
+    return distance;
+}
+
+// => -1 if some step of the path isn't an edge
+long long pathWeight(AdjacencyList& adj, std::vector<Node<int>*>& path){
+    long long total = 0;
+    for(size_t i = 0; i + 1 < path.size(); i++){
+        int u = path[i]->data, v = path[i+1]->data;
+        auto it = std::find_if(adj[u].begin(), adj[u].end(), [v](std::pair<int, int> edge){ return edge.first == v; });
+        if(it == adj[u].end()) return -1;
+        total += it->second;
+    }
+    return total;
+}
+
+// length is a path length from start to end (-1 for none), path has to be a real path of exactly that weight
+void checkPath(AdjacencyList& adj, long long expected, long long length, std::vector<Node<int>*>& path, Node<int>* start, Node<int>* end, std::string what){
+    check(length == expected, what + " length");
+    if(expected == -1){
+        check(path.empty(), what + " path of an unreachable pair");
+        return;
+    }
+    check(!path.empty() && path.front() == start && path.back() == end && pathWeight(adj, path) == expected, what + " path");
+}
+
+template <class D>
+void checkTree(std::vector<long long>& expected, ShortestPathTree<int, D>& tree, RandomGraph& random, std::string what){
+    for(size_t v = 0; v < expected.size(); v++){
+        check((long long)tree.distanceTo(random.nodes[v]) == expected[v], what + " distance");
+    }
+}
+
+void testShortestPaths(std::mt19937& rng){
+    for(int maxWeight : {20, 100000}){
+        RandomGraph random = randomGraph(80, 320, 0, maxWeight, rng);
+        CompressedGraph<int> graph(random.graph);
+        CompressedGraph<int> reverseGraph = graph.transposed();
+        WeightedTraversals<int> traversals;
+
+        for(int s = 0; s < 80; s += 9){
+            Node<int>* start = random.nodes[s];
+            std::vector<long long> expected = referenceDijkstra(random.adj, s);
+
+            for(std::string queueMethod : traversals.validQueueMethods()){
+                auto tree = traversals.djikstraShortestPathTree(graph, start, queueMethod);
+                checkTree(expected, tree, random, "Dijkstra (" + queueMethod + ")");
+            }
+            auto delta = traversals.deltaSteppingShortestPaths(graph, start);
+            checkTree(expected, delta, random, "delta-stepping");
+            auto narrowDelta = traversals.deltaSteppingShortestPaths(graph, start, 1);
+            checkTree(expected, narrowDelta, random, "delta-stepping (delta 1)");
+            auto bellmanFord = traversals.bellmanFordShortestPathTree(graph, start);
+            checkTree(expected, bellmanFord, random, "Bellman-Ford");
+            auto spfa = traversals.spfaShortestPathTree(graph, start);
+            checkTree(expected, spfa, random, "SPFA");
+            auto parallelBellmanFord = traversals.parallelBellmanFordShortestPathTree(graph, start);
+            checkTree(expected, parallelBellmanFord, random, "parallel Bellman-Ford");
+
+            for(int t = 0; t < 80; t += 7){
+                Node<int>* end = random.nodes[t];
+                auto [length, path] = traversals.djikstraShortestPath(graph, start, end);
+                checkPath(random.adj, expected[t], length, path, start, end, "Dijkstra");
+                auto [bidirectionalLength, bidirectionalPath] = traversals.bidirectionalDjikstraShortestPath(graph, reverseGraph, start, end);
+                checkPath(random.adj, expected[t], bidirectionalLength, bidirectionalPath, start, end, "bidirectional Dijkstra");
+                std::vector<Node<int>*> treePath = delta.pathTo(end);
+                checkPath(random.adj, expected[t], expected[t] == -1 ? -1 : pathWeight(random.adj, treePath), treePath, start, end, "delta-stepping");
+            }
+        }
+    }
+}
+
+void testDAGPaths(std::mt19937& rng){
+    RandomGraph random = randomGraph(70, 250, -20, 80, rng, true);
+    CompressedGraph<int> graph(random.graph);
+    WeightedTraversals<int> traversals;
+
+    std::vector<int> nodeWeights(70); // by CSR index
+    for(int v = 0; v < 70; v++) nodeWeights[graph.index(random.nodes[v])] = rng() % 10;
+
+    for(int s = 0; s < 70; s += 11){
+        // edges only go up in index, so index order is a topological order
+        std::vector<long long> shortest(70, -1), longest(70, -1), vertexWeighted(70, -1);
+        std::vector<char> reached(70, 0);
+        reached[s] = 1;
+        shortest[s] = longest[s] = 0;
+        vertexWeighted[s] = nodeWeights[graph.index(random.nodes[s])];
+        for(int u = s; u < 70; u++){
+            if(!reached[u]) continue;
+            for(auto [v, weight] : random.adj[u]){
+                long long throughU = vertexWeighted[u] + weight + nodeWeights[graph.index(random.nodes[v])];
+                if(!reached[v] || shortest[u] + weight < shortest[v]) shortest[v] = shortest[u] + weight;
+                if(!reached[v] || longest[u] + weight > longest[v]) longest[v] = longest[u] + weight;
+                if(!reached[v] || throughU < vertexWeighted[v]) vertexWeighted[v] = throughU;
+                reached[v] = 1;
+            }
+        }
+        auto shortestTree = traversals.DAGShortestPathTree(graph, random.nodes[s]);
+        auto longestTree = traversals.DAGLongestPathTree(graph, random.nodes[s]);
+        auto weightedTree = traversals.DAGShortestPathTree(graph, random.nodes[s], nodeWeights);
+        for(int v = 0; v < 70; v++){
+            check(shortestTree.isReachable(random.nodes[v]) == bool(reached[v]), "DAG shortest path reachability");
+            if(!reached[v]) continue;
+            check(shortestTree.distanceTo(random.nodes[v]) == shortest[v], "DAG shortest path distance");
+            check(longestTree.distanceTo(random.nodes[v]) == longest[v], "DAG longest path distance");
+            check(weightedTree.distanceTo(random.nodes[v]) == vertexWeighted[v], "vertex weighted DAG shortest path distance");
+        }
+    }
+}
+
+void testAllPairs(std::mt19937& rng){
+    // a DAG, so negative weights can't make a cycle.. Floyd-Warshall and Johnson both take them
+    RandomGraph random = randomGraph(50, 200, -30, 60, rng, true);
+    CompressedGraph<int> graph(random.graph);
+    WeightedTraversals<int> traversals;
+    auto [floydDistance, nextHop] = traversals.floydWarshallMatrix(graph);
+    auto [johnsonDistance, predecessor] = traversals.johnsonMatrix(graph, true);
+    const long long UNREACHABLE = WeightTraits<int>::unreachable();
+
+    for(int s = 0; s < 50; s++){
+        auto shortest = traversals.bellmanFordShortestPathTree(graph, random.nodes[s]);
+        int i = graph.index(random.nodes[s]);
+        for(int v = 0; v < 50; v++){
+            int j = graph.index(random.nodes[v]);
+            long long expected = shortest.distanceTo(random.nodes[v]);
+            check((floydDistance[i][j] == UNREACHABLE ? -1 : floydDistance[i][j]) == expected, "Floyd-Warshall distance");
+            check((johnsonDistance[i][j] == UNREACHABLE ? -1 : johnsonDistance[i][j]) == expected, "Johnson distance");
+            if(expected == -1) continue;
+
+            std::vector<Node<int>*> floydPath, johnsonPath;
+            for(int k : traversals.nextHopPath(nextHop, i, j)) floydPath.push_back(graph.nodes[k]);
+            for(int k : traversals.predecessorPath(predecessor, i, j)) johnsonPath.push_back(graph.nodes[k]);
+            check(pathWeight(random.adj, floydPath) == expected, "Floyd-Warshall path");
+            check(pathWeight(random.adj, johnsonPath) == expected, "Johnson path");
+        }
+    }
+}
+
+void testLandmarks(std::mt19937& rng){
+    RandomGraph random = randomGraph(100, 400, 1, 50, rng);
+    CompressedGraph<int> graph(random.graph);
+    WeightedTraversals<int> traversals;
+
+    for(std::string selectionMethod : Landmarks<int>::validSelectionMethods()){
+        Landmarks<int> landmarks(graph, 6, selectionMethod);
+        for(int s = 0; s < 100; s += 13){
+            std::vector<long long> expected = referenceDijkstra(random.adj, s);
+            for(int t = 0; t < 100; t += 3){
+                Node<int>* start = random.nodes[s];
+                Node<int>* end = random.nodes[t];
+                if(expected[t] != -1) check(landmarks.lowerBound(start, end) <= expected[t], "landmark lower bound is admissible");
+                auto [length, path] = traversals.alphaStarShortestPath(graph, start, end, landmarks.heuristicTo(end));
+                checkPath(random.adj, expected[t], length, path, start, end, "ALT (" + selectionMethod + ")");
+            }
+        }
+    }
+}
+
+void testContractionHierarchy(std::mt19937& rng){
+    RandomGraph random = randomGraph(120, 400, 1, 40, rng);
+    CompressedGraph<int> graph(random.graph);
+    ContractionHierarchy<int> hierarchy(graph);
+
+    std::string fileName = "tests_hierarchy.grc";
+    check(hierarchy.save(fileName), "contraction hierarchy save");
+    ContractionHierarchy<int> loaded;
+    check(loaded.load(fileName, graph), "contraction hierarchy load");
+    check(loaded.size() == hierarchy.size() && loaded.numShortcuts() == hierarchy.numShortcuts(), "loaded hierarchy size");
+
+    for(int s = 0; s < 120; s += 7){
+        std::vector<long long> expected = referenceDijkstra(random.adj, s);
+        for(int t = 0; t < 120; t++){
+            Node<int>* start = random.nodes[s];
+            Node<int>* end = random.nodes[t];
+            check(hierarchy.distance(start, end) == expected[t], "contraction hierarchy distance");
+            check(loaded.distance(start, end) == expected[t], "loaded contraction hierarchy distance");
+            auto [length, path] = hierarchy.shortestPath(start, end);
+            checkPath(random.adj, expected[t], length, path, start, end, "contraction hierarchy");
+            auto [loadedLength, loadedPath] = loaded.shortestPath(start, end);
+            checkPath(random.adj, expected[t], loadedLength, loadedPath, start, end, "loaded contraction hierarchy");
+        }
+    }
+
+    // the file belongs to the graph it was built from
+    random.graph.setWeight(random.nodes[0], random.adj[0].empty() ? random.nodes[1] : random.nodes[random.adj[0][0].first], 41);
+    if(random.adj[0].empty()) random.graph.addEdge(random.nodes[0], {random.nodes[1], 41});
+    CompressedGraph<int> changedGraph(random.graph);
+    ContractionHierarchy<int> stale;
+    check(!stale.load(fileName, changedGraph), "contraction hierarchy load refuses another graph");
+    std::remove(fileName.c_str());
+}
+
+void testReachabilityIndex(std::mt19937& rng){
+    RandomGraph random = randomGraph(150, 180, 1, 1, rng);
+    Graph<int> graph = random.graph.unweightedGraph();
+    ReachabilityIndex<int> index(graph);
+
+    auto checkAllPairs = [&](std::string what){
+        for(int s = 0; s < 150; s++){
+            std::vector<int> expected = referenceBFS(random.adj, s);
+            for(int t = 0; t < 150; t++) check(index.reachable(random.nodes[s], random.nodes[t]) == (expected[t] != -1), what);
+        }
+    };
+    checkAllPairs("reachability index");
+
+    // mutations are picked up on the next query
+    for(int round = 0; round < 3; round++){
+        for(int e = 0; e < 15; e++){
+            int u = rng() % 150, v = rng() % 150;
+            if(u == v) continue;
+            graph.addEdge(random.nodes[u], random.nodes[v]);
+            random.adj[u].push_back({v, 1});
+        }
+        check(index.isStale(), "reachability index notices a mutation");
+        checkAllPairs("reachability index after a mutation");
+    }
+
+    // doesPathExist answered from an index over the weighted graph
+    RandomGraph weighted = randomGraph(60, 70, 1, 9, rng);
+    ReachabilityIndex<int> weightedIndex(weighted.graph);
+    WeightedTraversals<int> traversals;
+    traversals.setReachabilityIndex(&weightedIndex);
+    for(int s = 0; s < 60; s += 5){
+        std::vector<int> expected = referenceBFS(weighted.adj, s);
+        for(int t = 0; t < 60; t++) check(traversals.doesPathExist(weighted.graph, weighted.nodes[s], weighted.nodes[t]) == (expected[t] != -1), "doesPathExist through a reachability index");
+    }
+}
+
+void testQueryCache(std::mt19937& rng){
+    RandomGraph random = randomGraph(40, 160, 1, 30, rng);
+    QueryCache<int> cache(random.graph, 4);
+    auto query = [&](int s, int t, std::string what){
+        auto [length, path] = cache.djikstraShortestPath(random.nodes[s], random.nodes[t]);
+        checkPath(random.adj, referenceDijkstra(random.adj, s)[t], length, path, random.nodes[s], random.nodes[t], what);
+    };
+
+    for(int q = 0; q < 4; q++) query(q, 39 - q, "query cache miss");
+    check(cache.size() == 4 && cache.misses() == 4 && cache.hits() == 0, "query cache fills up");
+    query(0, 39, "query cache hit");
+    check(cache.hits() == 1, "query cache hit is counted");
+
+    // (0, 39) was just used, so the least recently used entry is (1, 38)
+    query(4, 35, "query cache miss");
+    check(cache.size() == 4, "query cache stays within its capacity");
+    size_t misses = cache.misses();
+    query(0, 39, "query cache hit after an eviction");
+    check(cache.misses() == misses, "query cache keeps the recently used entry");
+    query(1, 38, "query cache miss after an eviction");
+    check(cache.misses() == misses + 1, "query cache evicts the least recently used entry");
+
+    // a mutation drops everything, and the next answer is for the changed graph
+    int u = 0;
+    while(random.adj[u].empty()) u++;
+    random.adj[u][0].second = 1000;
+    random.graph.setWeight(random.nodes[u], random.nodes[random.adj[u][0].first], 1000);
+    check(cache.isStale(), "query cache notices a mutation");
+    misses = cache.misses();
+    query(0, 39, "query cache after a mutation");
+    check(cache.misses() == misses + 1 && cache.size() == 1, "query cache is emptied by a mutation");
+
+    Graph<int> graph = random.graph.unweightedGraph();
+    QueryCache<int> unweightedCache(graph, 16);
+    for(int repeat = 0; repeat < 2; repeat++){
+        for(int s = 0; s < 40; s += 8){
+            std::vector<int> expected = referenceBFS(random.adj, s);
+            auto [hops, path] = unweightedCache.shortestPath(random.nodes[s], random.nodes[39]);
+            check(hops == expected[39], "query cache BFS length");
+        }
+    }
+    check(unweightedCache.hits() == 5, "query cache BFS hits");
+}
+
+void testDynamicShortestPathTree(std::mt19937& rng){
+    RandomGraph random = randomGraph(60, 240, 1, 50, rng);
+    DynamicShortestPathTree<int> tree(random.graph, random.nodes[0]);
+
+    auto checkTree = [&](std::string what){
+        std::vector<long long> expected = referenceDijkstra(random.adj, 0);
+        for(int v = 0; v < 60; v++){
+            check(tree.distanceTo(random.nodes[v]) == expected[v], what + " distance");
+            std::vector<Node<int>*> path = tree.pathTo(random.nodes[v]);
+            if(expected[v] != -1) check(pathWeight(random.adj, path) == expected[v], what + " path");
+        }
+    };
+    checkTree("dynamic shortest path tree");
+
+    for(int update = 0; update < 300; update++){
+        int u = rng() % 60;
+        int kind = rng() % 5;
+        if(kind < 4 && !random.adj[u].empty()){
+            // lighter (kind 0, 1) or heavier (kind 2, 3) existing edge
+            auto& edge = random.adj[u][rng() % random.adj[u].size()];
+            int weight = kind < 2 ? int(rng() % (edge.second + 1)) : edge.second + 1 + int(rng() % 60);
+            edge.second = weight;
+            tree.setWeight(random.nodes[u], random.nodes[edge.first], weight);
+        }
+        else{
+            int v = rng() % 60;
+            bool exists = std::any_of(random.adj[u].begin(), random.adj[u].end(), [v](std::pair<int, int> edge){ return edge.first == v; });
+            if(u == v || exists) continue;
+            int weight = 1 + rng() % 50;
+            random.adj[u].push_back({v, weight});
+            tree.addEdge(random.nodes[u], {random.nodes[v], weight});
+        }
+        if(update % 10 == 0) checkTree("repaired dynamic shortest path tree");
+    }
+    checkTree("repaired dynamic shortest path tree");
+
+    // changed behind the tree's back => rebuilt
+    int u = 0;
+    while(random.adj[u].empty()) u++;
+    random.adj[u][0].second = 7;
+    random.graph.setWeight(random.nodes[u], random.nodes[random.adj[u][0].first], 7);
+    check(tree.isStale(), "dynamic shortest path tree notices an outside mutation");
+    checkTree("rebuilt dynamic shortest path tree");
+}
+
+void testSpanningForests(std::mt19937& rng){
+    // sparse enough to leave a few components
+    RandomGraph random = randomGraph(90, 110, 1, 25, rng);
+    CompressedGraph<int> graph(random.graph);
+    WeightedTraversals<int> traversals;
+
+    // plain Kruskal, edge directions ignored
+    std::vector<std::tuple<int, int, int>> edges;
+    for(int u = 0; u < 90; u++) for(auto [v, weight] : random.adj[u]) edges.push_back({weight, u, v});
+    std::sort(edges.begin(), edges.end());
+    std::vector<int> parent(90);
+    for(int v = 0; v < 90; v++) parent[v] = v;
+    std::function<int(int)> root = [&](int v){ return parent[v] == v ? v : parent[v] = root(parent[v]); };
+    long long expectedWeight = 0;
+    int expectedTrees = 90;
+    for(auto [weight, u, v] : edges){
+        if(root(u) == root(v)) continue;
+        parent[root(u)] = root(v);
+        expectedWeight += weight;
+        expectedTrees--;
+    }
+
+    std::vector<std::tuple<std::string, SpanningForest<int>>> forests;
+    for(std::string kruskalMethod : traversals.validKruskalMethods()) forests.push_back({"Kruskal (" + kruskalMethod + ")", traversals.kruskalMinimumSpanningForest(graph, kruskalMethod)});
+    forests.push_back({"Prim", traversals.primMinimumSpanningForest(graph)});
+    forests.push_back({"Boruvka", traversals.boruvkaMinimumSpanningForest(graph)});
+    for(auto& [name, forest] : forests){
+        check(forest.totalWeight() == expectedWeight, name + " spanning forest weight");
+        check(forest.numTrees() == expectedTrees, name + " spanning forest trees");
+    }
+}
+
+void testKShortestPaths(std::mt19937& rng){
+    for(int round = 0; round < 5; round++){
+        RandomGraph random = randomGraph(9, 28, 1, 20, rng);
+        WeightedTraversals<int> traversals;
+
+        // every simple path from 0 to 8
+        std::vector<long long> lengths;
+        std::vector<char> onPath(9, 0);
+        std::function<void(int, long long)> walk = [&](int u, long long length){
+            if(u == 8){ lengths.push_back(length); return; }
+            onPath[u] = 1;
+            for(auto [v, weight] : random.adj[u]) if(!onPath[v]) walk(v, length + weight);
+            onPath[u] = 0;
+        };
+        walk(0, 0);
+        std::sort(lengths.begin(), lengths.end());
+
+        int k = 6;
+        auto paths = traversals.kShortestPaths(random.graph, random.nodes[0], random.nodes[8], k);
+        check(int(paths.size()) == std::min(k, int(lengths.size())), "k shortest paths count");
+        std::set<std::vector<Node<int>*>> distinct;
+        for(size_t i = 0; i < paths.size() && i < lengths.size(); i++){
+            auto& [length, path] = paths[i];
+            check(length == lengths[i], "k shortest paths length");
+            checkPath(random.adj, lengths[i], length, path, random.nodes[0], random.nodes[8], "k shortest paths");
+            check(std::set<Node<int>*>(path.begin(), path.end()).size() == path.size(), "k shortest paths are loopless");
+            distinct.insert(path);
+        }
+        check(distinct.size() == paths.size(), "k shortest paths are distinct");
+    }
+}
+
+void testEccentricity(std::mt19937& rng){
+    // undirected: every edge both ways
+    RandomGraph random = randomGraph(70, 90, 1, 1, rng);
+    Graph<int> graph;
+    AdjacencyList undirected(70);
+    for(auto node : random.nodes) graph.addNode(node, {});
+    for(int u = 0; u < 70; u++){
+        for(auto [v, weight] : random.adj[u]){
+            graph.addEdge(random.nodes[u], random.nodes[v]);
+            graph.addEdge(random.nodes[v], random.nodes[u]);
+            undirected[u].push_back({v, 1});
+            undirected[v].push_back({u, 1});
+        }
+    }
+
+    Eccentricity<int> eccentricity;
+    auto eccentricities = eccentricity.eccentricities(graph);
+    long long diameter = 0, radius = -1;
+    for(int v = 0; v < 70; v++){
+        std::vector<int> distance = referenceBFS(undirected, v);
+        long long expected = *std::max_element(distance.begin(), distance.end());
+        check(eccentricities[random.nodes[v]] == expected, "eccentricity");
+        diameter = std::max(diameter, expected);
+        radius = radius == -1 ? expected : std::min(radius, expected);
+    }
+    check(eccentricity.diameter(graph) == diameter, "diameter");
+    check(eccentricity.radius(graph) == radius, "radius");
+    auto [lower, upper] = eccentricity.approximateDiameter(graph, 2);
+    check(lower <= diameter && diameter <= upper, "approximate diameter bounds");
+
+    // directed and weighted: the largest distance to anything reachable
+    RandomGraph weighted = randomGraph(50, 200, 1, 30, rng);
+    auto directedEccentricities = eccentricity.eccentricities(weighted.graph, true);
+    for(int v = 0; v < 50; v++){
+        std::vector<long long> distance = referenceDijkstra(weighted.adj, v);
+        check(directedEccentricities[weighted.nodes[v]] == *std::max_element(distance.begin(), distance.end()), "directed weighted eccentricity");
+    }
+}
+
+void testBetweennessCentrality(std::mt19937& rng){
+    RandomGraph random = randomGraph(30, 80, 1, 1, rng);
+    Graph<int> graph = random.graph.unweightedGraph();
+
+    // from the definition: the share of the s-t shortest paths through v, over ordered pairs
+    std::vector<std::vector<int>> distance(30);
+    std::vector<std::vector<double>> numPaths(30, std::vector<double>(30, 0));
+    for(int s = 0; s < 30; s++){
+        distance[s] = referenceBFS(random.adj, s);
+        std::vector<int> order(30);
+        for(int v = 0; v < 30; v++) order[v] = v;
+        std::sort(order.begin(), order.end(), [&](int a, int b){ return distance[s][a] < distance[s][b]; });
+        numPaths[s][s] = 1;
+        for(int u : order){
+            if(distance[s][u] == -1) continue;
+            for(auto [v, weight] : random.adj[u]) if(distance[s][v] == distance[s][u] + 1) numPaths[s][v] += numPaths[s][u];
+        }
+    }
+    Centrality<int> centrality;
+    auto betweenness = centrality.betweennessCentrality(graph);
+    for(int v = 0; v < 30; v++){
+        double expected = 0;
+        for(int s = 0; s < 30; s++){
+            for(int t = 0; t < 30; t++){
+                if(s == v || t == v || s == t || distance[s][t] == -1 || distance[s][v] == -1 || distance[v][t] == -1) continue;
+                if(distance[s][v] + distance[v][t] == distance[s][t]) expected += numPaths[s][v] * numPaths[v][t] / numPaths[s][t];
+            }
+        }
+        check(std::fabs(betweenness[random.nodes[v]] - expected) < 1e-6, "betweenness centrality");
+    }
+}
+
+void testTriangles(std::mt19937& rng){
+    RandomGraph random = randomGraph(60, 400, 1, 1, rng);
+    Graph<int> graph = random.graph.unweightedGraph();
+    std::vector<std::vector<char>> connected(60, std::vector<char>(60, 0));
+    for(int u = 0; u < 60; u++) for(auto [v, weight] : random.adj[u]) connected[u][v] = connected[v][u] = 1;
+
+    long long expected = 0;
+    for(int a = 0; a < 60; a++) for(int b = a + 1; b < 60; b++) for(int c = b + 1; c < 60; c++) expected += connected[a][b] && connected[b][c] && connected[a][c];
+    Clustering<int> clustering;
+    check(clustering.numTriangles(graph) == expected, "number of triangles");
+}
+
+void testTravellingSalesman(std::mt19937& rng){
+    WeightedTraversals<int> traversals;
+    for(int round = 0; round < 5; round++){
+        int V = 8;
+        WeightedAdjacencyMatrix<int> weights(V, 0);
+        for(int u = 0; u < V; u++) for(int v = 0; v < V; v++) if(u != v) weights[u][v] = 1 + rng() % 100;
+
+        std::vector<int> order;
+        for(int v = 1; v < V; v++) order.push_back(v);
+        long long expected = -1;
+        do{
+            long long length = weights[0][order[0]] + weights[order.back()][0];
+            for(int i = 0; i + 1 < V - 1; i++) length += weights[order[i]][order[i+1]];
+            if(expected == -1 || length < expected) expected = length;
+        } while(std::next_permutation(order.begin(), order.end()));
+
+        auto [length, tour] = traversals.travellingSalesmanTour(weights, 0);
+        check(length == expected, "Held-Karp tour length");
+        long long walked = 0;
+        for(size_t i = 0; i + 1 < tour.size(); i++) walked += weights[tour[i]][tour[i+1]];
+        check(int(tour.size()) == V + 1 && walked == length, "Held-Karp tour");
+    }
+
+    // the heuristic has to come back with a real tour whose length adds up
+    int V = 60;
+    WeightedAdjacencyMatrix<int> weights(V, 0);
+    for(int u = 0; u < V; u++) for(int v = 0; v < V; v++) if(u != v) weights[u][v] = 1 + rng() % 1000;
+    auto [length, tour] = traversals.approximateTravellingSalesmanTour(weights, 5, 0.1);
+    std::vector<int> visits(V, 0);
+    long long walked = 0;
+    for(size_t i = 0; i + 1 < tour.size(); i++){
+        visits[tour[i]]++;
+        walked += weights[tour[i]][tour[i+1]];
+    }
+    check(int(tour.size()) == V + 1 && tour.front() == 5 && tour.back() == 5, "heuristic tour ends");
+    check(std::all_of(visits.begin(), visits.end(), [](int count){ return count == 1; }), "heuristic tour visits every node once");
+    check(walked == length, "heuristic tour length");
+}
+
+int main(){
+    std::mt19937 rng(2024);
+
+    testShortestPaths(rng);
+    testDAGPaths(rng);
+    testAllPairs(rng);
+    testLandmarks(rng);
+    testContractionHierarchy(rng);
+    testReachabilityIndex(rng);
+    testQueryCache(rng);
+    testDynamicShortestPathTree(rng);
+    testSpanningForests(rng);
+    testKShortestPaths(rng);
+    testEccentricity(rng);
+    testBetweennessCentrality(rng);
+    testTriangles(rng);
+    testTravellingSalesman(rng);
+
+    std::cout << numChecks - numFailures << "/" << numChecks << " checks passed\n";
+    return numFailures == 0 ? 0 : 1;
+}